@@ -0,0 +1,157 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Checks the "Heap allocations" guarantees of the README.
+// Exits with a non-zero status if any of them is broken.
+
+// Utilities
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Count every heap allocation
+static std::atomic<std::size_t> allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    allocations++;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    allocations++;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    size = (size + alignment - 1) / alignment * alignment;
+    if (void *p = std::aligned_alloc(alignment, size ? size : alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+// Declare services
+class SingletonService
+{
+public:
+    virtual int foo() = 0;
+    virtual ~SingletonService() {};
+};
+
+class ThreadSingletonService
+{
+public:
+    virtual int foo() = 0;
+    virtual ~ThreadSingletonService() {};
+};
+
+class SetService
+{
+public:
+    virtual int foo() = 0;
+    virtual ~SetService() {};
+};
+
+// Declare service providers
+class SingletonProvider : public SingletonService
+{
+public:
+    virtual int foo() override { return 1; };
+};
+
+class ThreadSingletonProvider : public ThreadSingletonService
+{
+public:
+    virtual int foo() override { return 2; };
+};
+
+class SetProvider1 : public SetService
+{
+public:
+    virtual int foo() override { return 3; };
+};
+
+class SetProvider2 : public SetService
+{
+public:
+    virtual int foo() override { return 4; };
+};
+
+static int failures = 0;
+
+// Run a scenario and compare its heap allocations with the expected count
+template <class Scenario>
+void check(const char *name, std::size_t expected, Scenario scenario)
+{
+    scenario(); // Warm up: constructs singletons and thread-local storage
+    std::size_t before = allocations.load();
+    scenario();
+    std::size_t count = allocations.load() - before;
+    std::cout << (count == expected ? "PASS " : "FAIL ") << name
+              << ": " << count << " allocation(s), expected "
+              << expected << std::endl;
+    if (count != expected)
+        failures++;
+}
+
+int main()
+{
+    dip::inject_singleton<SingletonService, SingletonProvider>();
+    dip::inject_thread_singleton<ThreadSingletonService, ThreadSingletonProvider>();
+    dip::add_singleton<SetService, SetProvider1>();
+    dip::add_singleton<SetService, SetProvider2>();
+
+    int sink = 0;
+
+    check("singleton acquire/release", 0, [&]()
+          { dip::instance<SingletonService> instance;
+            sink += instance->foo(); });
+
+    check("thread singleton acquire/release", 0, [&]()
+          { dip::instance<ThreadSingletonService> instance;
+            sink += instance->foo(); });
+
+    dip::instance_set<SetService> set;
+    check("instance_set iteration", 0, [&]()
+          { for (auto provider : set)
+                sink += provider->foo(); });
+
+    check("instance_set<Service> acquire/release", 1, [&]()
+          { dip::instance_set<SetService> instances;
+            sink += instances[0]->foo(); });
+
+    check("instance_set<Service, MaxN> acquire/release", 0, [&]()
+          { dip::instance_set<SetService, 4> instances;
+            for (auto provider : instances)
+                sink += provider->foo(); });
+
+    std::cout << "(" << sink << ")" << std::endl;
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
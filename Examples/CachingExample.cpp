@@ -0,0 +1,77 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Utilities
+#include <iostream>
+#include <string>
+#include <chrono>
+
+// Import the framework
+#include "../dip.hpp"
+#include "../dip_cache.hpp"
+
+// Declare a service having a pure lookup method
+class UserDirectory
+{
+public:
+    virtual std::string name(int id) = 0;
+    virtual ~UserDirectory() {};
+};
+
+// Declare the real service provider.
+// Let's pretend every lookup reaches a slow backend.
+class BackendUserDirectory : public UserDirectory
+{
+public:
+    virtual std::string name(int id) override
+    {
+        std::cout << "(backend lookup of " << id << ")" << std::endl;
+        return "user" + std::to_string(id);
+    };
+};
+
+// Declare a caching decorator.
+// It wraps the real service provider and memoizes lookups.
+// On a cache miss, concurrent lookups of the same id
+// are coalesced into a single backend lookup.
+class CachingUserDirectory : public UserDirectory
+{
+public:
+    virtual std::string name(int id) override
+    {
+        return cache.get(id, [this, id]()
+                         { return flights.call(id, [this, id]()
+                                               { return backend.name(id); }); });
+    };
+
+    ~CachingUserDirectory()
+    {
+        std::cout << "Hit rate: " << cache.hit_rate() << std::endl;
+    };
+
+private:
+    BackendUserDirectory backend;
+    dip::memo_cache<int, std::string> cache{1000, std::chrono::minutes(5)};
+    dip::single_flight<int, std::string> flights;
+};
+
+// Service consumer: not aware of the cache
+void test()
+{
+    dip::instance<UserDirectory> directory;
+    for (int id : {1, 2, 1, 1, 2, 3})
+        std::cout << directory->name(id) << std::endl;
+}
+
+int main()
+{
+    // Inject the decorator instead of the real service provider
+    dip::inject_singleton<UserDirectory, CachingUserDirectory>();
+
+    // Consume
+    test();
+}
@@ -0,0 +1,103 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Utilities
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service
+class PriceService
+{
+public:
+    virtual double price(std::int32_t id) = 0;
+    virtual ~PriceService() {};
+};
+
+// Declare a service provider.
+// Let's pretend prices are expensive to compute,
+// so they are cached. The cache is "warm state"
+// worth keeping between runs.
+class CachedPriceProvider : public PriceService
+{
+public:
+    virtual double price(std::int32_t id) override
+    {
+        auto found = cache.find(id);
+        if (found != cache.end())
+            return found->second;
+        std::cout << "(computing " << id << ") ";
+        return cache[id] = id * 1.5;
+    };
+
+    // Save the warm state
+    void save(dip::checkpoint_writer &writer) const
+    {
+        writer.write(static_cast<std::uint64_t>(cache.size()));
+        for (auto &entry : cache)
+        {
+            writer.write(entry.first);
+            writer.write(entry.second);
+        }
+    }
+
+    // Restore the warm state.
+    // Nothing is changed unless the whole section is valid.
+    bool load(dip::checkpoint_reader &reader)
+    {
+        std::unordered_map<std::int32_t, double> restored;
+        std::uint64_t count;
+        if (!reader.read(count))
+            return false;
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            std::int32_t id;
+            double value;
+            if (!reader.read(id) || !reader.read(value))
+                return false;
+            restored[id] = value;
+        }
+        if (!reader.exhausted())
+            return false;
+        cache = std::move(restored);
+        return true;
+    }
+
+private:
+    std::unordered_map<std::int32_t, double> cache;
+};
+
+// Service consumer
+void test()
+{
+    dip::instance<PriceService> prices;
+    for (std::int32_t id = 1; id <= 3; id++)
+        std::cout << "price(" << id << ") = " << prices->price(id) << std::endl;
+}
+
+int main()
+{
+    const std::string filename = "prices.ckpt";
+    const std::uint32_t version = 1;
+
+    // Restore the warm state of the previous run, if any.
+    // Run this example twice: the second run computes nothing.
+    if (dip::checkpoint::restore(filename, version))
+        std::cout << "== Warm start ==" << std::endl;
+    else
+        std::cout << "== Cold start ==" << std::endl;
+
+    dip::inject_singleton<PriceService, CachedPriceProvider>();
+    test();
+
+    // Save the warm state for the next run
+    dip::checkpoint::save(filename, version);
+}
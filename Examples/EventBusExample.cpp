@@ -0,0 +1,71 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Utilities
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+// Import the framework
+#include "../dip.hpp"
+#include "../dip_event_bus.hpp"
+
+// Declare an event type.
+// Must be default-constructible and copy-assignable.
+struct PriceChanged
+{
+    int id = 0;
+    double price = 0.0;
+};
+
+// Declare a subscriber.
+// Events are delivered in batches from a dispatcher thread.
+class PriceLogger : public dip::Subscriber<PriceChanged>
+{
+public:
+    virtual void on_events(const PriceChanged *events, std::size_t count) override
+    {
+        for (std::size_t i = 0; i < count; i++)
+            std::cout << "PriceLogger: " << events[i].id
+                      << " -> " << events[i].price << std::endl;
+    };
+};
+
+// Declare a slow subscriber.
+// It does not throttle the publisher nor other subscribers.
+class PriceArchiver : public dip::Subscriber<PriceChanged>
+{
+public:
+    virtual void on_events(const PriceChanged *, std::size_t count) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        archived += count;
+    };
+
+    ~PriceArchiver()
+    {
+        std::cout << "PriceArchiver: " << archived << " events archived" << std::endl;
+    };
+
+private:
+    std::size_t archived = 0;
+};
+
+int main()
+{
+    // Subscribe
+    dip::add_singleton<dip::Subscriber<PriceChanged>, PriceLogger>();
+    dip::add_transient<dip::Subscriber<PriceChanged>, PriceArchiver>();
+
+    // Publish.
+    // Pending events are delivered when the bus is destroyed.
+    {
+        dip::event_bus<PriceChanged> bus;
+        for (int id = 1; id <= 5; id++)
+            bus.publish({id, id * 1.5});
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Utilities
+#include <iostream>
+#include <array>
+
+// Import the framework
+#include "../dip.hpp"
+#include "../dip_parallel.hpp"
+
+// Declare a service
+class Scorer
+{
+public:
+    virtual double score(int item) = 0;
+    virtual ~Scorer() {};
+};
+
+// Declare a service provider.
+// Many instances will be injected, having different weights.
+class WeightedScorer : public Scorer
+{
+public:
+    virtual double score(int item) override
+    {
+        return item * weight;
+    };
+
+    WeightedScorer(double weight) : weight{weight} {};
+
+private:
+    double weight;
+};
+
+// Consume all the service providers in parallel
+void test()
+{
+    dip::instance_set<Scorer> scorers;
+    std::array<double, 3> scores;
+    for (int item = 1; item <= 3; item++)
+    {
+        dip::gather(
+            scorers,
+            [item](Scorer *scorer)
+            { return scorer->score(item); },
+            scores.begin());
+        std::cout << "item " << item << ":";
+        for (auto score : scores)
+            std::cout << " " << score;
+        std::cout << std::endl;
+    }
+}
+
+int main()
+{
+    // Inject a shared thread pool having 2 worker threads.
+    // Any other service provider may consume it, too.
+    dip::inject_singleton<dip::Executor, dip::work_stealing_executor>(2);
+
+    // Inject the scorers
+    dip::add_transient<Scorer, WeightedScorer>(0.5);
+    dip::add_transient<Scorer, WeightedScorer>(1.0);
+    dip::add_transient<Scorer, WeightedScorer>(2.0);
+
+    // Consume
+    test();
+}
@@ -0,0 +1,201 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Generator of large synthetic service graphs, to benchmark startup.
+//
+// Writes to the standard output a program having thousands of services
+// in layers (depth), each service provider consuming a number
+// of services from the next layer (fan-out), wired through
+// dip::inject_*() and dip::add_*() with mixed life cycles.
+// Service providers acquire their dependencies when constructed,
+// so the first request constructs the whole graph (lazy initialization).
+//
+// The generated program is its own harness. It prints:
+// - total wiring time
+// - time to first request (since program start, wiring included)
+// - RSS after warmup (Linux only)
+//
+// Usage:
+//   GraphGeneratorExample [services [depth [fan-out [seed]]]] > graph.cpp
+//   g++ -std=c++20 -O1 -I<path to dip.hpp> -pthread graph.cpp -o graph
+//   ./graph
+//
+// Note: thousands of services take minutes to compile.
+
+// Utilities
+#include <iostream>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Life cycle of a generated service
+enum class lifecycle
+{
+    singleton,
+    thread_singleton,
+    transient,
+    set_singleton
+};
+
+static lifecycle choose_lifecycle(std::size_t index)
+{
+    // 60% singletons, 20% thread singletons,
+    // 10% transients and 10% in a service provider set
+    switch (index % 10)
+    {
+    case 6:
+    case 7:
+        return lifecycle::thread_singleton;
+    case 8:
+        return lifecycle::transient;
+    case 9:
+        return lifecycle::set_singleton;
+    default:
+        return lifecycle::singleton;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t services = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    std::size_t depth = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 6;
+    std::size_t fanout = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 3;
+    unsigned seed = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 42;
+    if ((depth == 0) || (services < depth))
+    {
+        std::cerr << "Invalid arguments" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Assign services to layers. Layer 0 are the roots.
+    std::vector<std::vector<std::size_t>> layers(depth);
+    for (std::size_t i = 0; i < services; i++)
+        layers[i * depth / services].push_back(i);
+
+    // Choose the dependencies of every service from the next layer.
+    // Services in a service provider set are consumed through the set.
+    std::mt19937 random(seed);
+    std::vector<lifecycle> lifecycles(services);
+    std::vector<std::vector<std::size_t>> dependencies(services);
+    for (std::size_t i = 0; i < services; i++)
+        lifecycles[i] = choose_lifecycle(i);
+    for (std::size_t layer = 0; layer + 1 < depth; layer++)
+    {
+        std::vector<std::size_t> candidates;
+        for (std::size_t j : layers[layer + 1])
+            if (lifecycles[j] != lifecycle::set_singleton)
+                candidates.push_back(j);
+        if (candidates.empty())
+            continue;
+        for (std::size_t i : layers[layer])
+            for (std::size_t k = 0; k < fanout; k++)
+                dependencies[i].push_back(candidates[random() % candidates.size()]);
+    }
+
+    std::ostream &out = std::cout;
+    out << "// Generated by GraphGeneratorExample: "
+        << services << " services, depth " << depth
+        << ", fan-out " << fanout << ", seed " << seed << "\n";
+    out << "#include <chrono>\n#include <cstdint>\n#include <fstream>\n"
+           "#include <iostream>\n#include <unistd.h>\n#include \"dip.hpp\"\n\n";
+    out << "static const auto program_start = std::chrono::steady_clock::now();\n\n";
+
+    // Services in a service provider set share a service
+    out << "class Plugin\n{\npublic:\n"
+           "    virtual std::uint64_t value() = 0;\n"
+           "    virtual ~Plugin() {};\n};\n\n";
+
+    // Declare services
+    for (std::size_t i = 0; i < services; i++)
+        if (lifecycles[i] != lifecycle::set_singleton)
+            out << "class S" << i << "\n{\npublic:\n"
+                << "    virtual std::uint64_t value() = 0;\n"
+                << "    virtual ~S" << i << "() {};\n};\n";
+    out << "\n";
+
+    // Declare service providers. They are declared in reverse order,
+    // so dependencies are complete types.
+    for (std::size_t n = services; n-- > 0;)
+    {
+        bool plugin = (lifecycles[n] == lifecycle::set_singleton);
+        out << "class P" << n << " : public " << (plugin ? "Plugin" : "S" + std::to_string(n))
+            << "\n{\npublic:\n"
+            << "    virtual std::uint64_t value() override { return _value; }\n"
+            << "    P" << n << "()\n    {\n"
+            << "        _value = " << n << ";\n";
+        for (std::size_t k = 0; k < dependencies[n].size(); k++)
+            out << "        _value += d" << k << "->value();\n";
+        out << "    }\n\nprivate:\n";
+        for (std::size_t k = 0; k < dependencies[n].size(); k++)
+            out << "    dip::instance<S" << dependencies[n][k] << "> d" << k << ";\n";
+        out << "    std::uint64_t _value;\n};\n";
+    }
+    out << "\n";
+
+    // Wiring
+    out << "static void wire()\n{\n";
+    for (std::size_t i = 0; i < services; i++)
+    {
+        switch (lifecycles[i])
+        {
+        case lifecycle::singleton:
+            out << "    dip::inject_singleton<S" << i << ", P" << i << ">();\n";
+            break;
+        case lifecycle::thread_singleton:
+            out << "    dip::inject_thread_singleton<S" << i << ", P" << i << ">();\n";
+            break;
+        case lifecycle::transient:
+            out << "    dip::inject_transient<S" << i << ", P" << i << ">();\n";
+            break;
+        case lifecycle::set_singleton:
+            out << "    dip::add_singleton<Plugin, P" << i << ">();\n";
+            break;
+        }
+    }
+    out << "}\n\n";
+
+    // A request consumes every root service and every plugin
+    out << "static std::uint64_t request()\n{\n    std::uint64_t sum = 0;\n";
+    for (std::size_t i : layers[0])
+        if (lifecycles[i] != lifecycle::set_singleton)
+            out << "    sum += dip::instance<S" << i << ">()->value();\n";
+    out << "    dip::instance_set<Plugin> plugins;\n"
+           "    for (auto plugin : plugins)\n"
+           "        sum += plugin->value();\n"
+           "    return sum;\n}\n\n";
+
+    // Harness
+    out << R"harness(static std::size_t rss_kib()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+int main()
+{
+    using clock = std::chrono::steady_clock;
+    using ms = std::chrono::duration<double, std::milli>;
+    auto t0 = clock::now();
+    wire();
+    auto t1 = clock::now();
+    std::uint64_t sum = request();
+    auto t2 = clock::now();
+    for (int i = 0; i < 100; i++)
+        sum += request();
+    auto t3 = clock::now();
+    std::cout << "wiring time:           " << ms(t1 - t0).count() << " ms" << std::endl;
+    std::cout << "first request:         " << ms(t2 - t1).count() << " ms" << std::endl;
+    std::cout << "time to first request: " << ms(t2 - program_start).count() << " ms" << std::endl;
+    std::cout << "warm request:          " << ms(t3 - t2).count() / 100 << " ms" << std::endl;
+    std::cout << "RSS after warmup:      " << rss_kib() << " KiB" << std::endl;
+    std::cout << "(" << sum % 10 << ")" << std::endl;
+}
+)harness";
+}
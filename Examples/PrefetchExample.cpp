@@ -0,0 +1,130 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Benchmark of dip::for_each_prefetched() against plain iteration
+// on sets of service providers scattered in the heap.
+// Caches are flushed before every pass, so each provider is a cache miss.
+
+// Utilities
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service
+class MyService
+{
+public:
+    virtual std::uint64_t foo() = 0;
+    virtual ~MyService() {};
+};
+
+// Declare some service providers.
+// Each call reads and writes the provider's own state.
+template <int Kind>
+class MyServiceProvider : public MyService
+{
+public:
+    virtual std::uint64_t foo() override
+    {
+        state[0] += Kind;
+        return state[0] + state[7];
+    };
+
+private:
+    std::uint64_t state[8] = {};
+};
+
+// Allocate a provider of any kind
+static MyService *make_provider(std::size_t index)
+{
+    switch (index % 4)
+    {
+    case 0:
+        return new MyServiceProvider<0>();
+    case 1:
+        return new MyServiceProvider<1>();
+    case 2:
+        return new MyServiceProvider<2>();
+    default:
+        return new MyServiceProvider<3>();
+    }
+}
+
+// Evict the providers from all cache levels
+static void flush_caches()
+{
+    static std::vector<char> buffer(64 * 1024 * 1024);
+    for (std::size_t i = 0; i < buffer.size(); i += 64)
+        buffer[i]++;
+}
+
+// Time one pass over the set, in nanoseconds per provider
+template <class Pass>
+double measure(std::size_t count, Pass pass)
+{
+    const int passes = 20;
+    double total = 0;
+    for (int i = 0; i < passes; i++)
+    {
+        flush_caches();
+        auto t0 = std::chrono::steady_clock::now();
+        pass();
+        auto t1 = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+    return total / passes / count;
+}
+
+int main()
+{
+    std::mt19937 random(42);
+    std::vector<std::unique_ptr<char[]>> padding;
+    std::vector<MyService *> providers;
+    std::uint64_t sink = 0;
+
+    std::cout << "providers, plain (ns), prefetched (ns)" << std::endl;
+    for (std::size_t count : {256, 1024, 4096})
+    {
+        // Inject service providers scattered in the heap,
+        // in random order
+        dip::instance_set<MyService>::clear_injections();
+        for (std::size_t i = providers.size(); i < count; i++)
+        {
+            providers.push_back(make_provider(i));
+            padding.emplace_back(new char[64 + random() % 4096]);
+        }
+        std::vector<MyService *> order(providers.begin(), providers.end());
+        std::shuffle(order.begin(), order.end(), random);
+        for (MyService *provider : order)
+            dip::add<MyService>({.acquire = [provider]()
+                                 { return provider; }});
+
+        // Consume
+        dip::instance_set<MyService> set;
+        double plain = measure(count, [&]()
+                               { for (auto provider : set)
+                                     sink += provider->foo(); });
+        double prefetched = measure(count, [&]()
+                                    { dip::for_each_prefetched(
+                                          set,
+                                          [&](MyService *provider)
+                                          { sink += provider->foo(); },
+                                          8); });
+        std::cout << count << ", " << plain << ", " << prefetched << std::endl;
+    }
+    std::cout << "(" << sink % 10 << ")" << std::endl;
+
+    for (MyService *provider : providers)
+        delete provider;
+}
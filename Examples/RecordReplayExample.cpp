@@ -0,0 +1,130 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Utilities
+#include <iostream>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ctime>
+#include <cassert>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service
+class PriceService
+{
+public:
+    virtual double price(std::int32_t id) = 0;
+    virtual ~PriceService() {};
+};
+
+// Declare the real service provider.
+// Let's pretend it is expensive and non-deterministic.
+class RealPriceProvider : public PriceService
+{
+public:
+    virtual double price(std::int32_t id) override
+    {
+        return id * 1.5 + (clock() % 100) / 100.0;
+    };
+};
+
+// Binary record of a single call: arguments and return value
+struct PriceRecord
+{
+    std::int32_t id;
+    double result;
+};
+
+// Declare a service provider that records every call
+// to another service provider into a binary file.
+//
+// Records are written as they are, with no formatting,
+// so recording overhead is low.
+// Service consumers may run in many threads,
+// so writes to the shared file are serialized.
+class RecordingPriceProvider : public PriceService
+{
+public:
+    virtual double price(std::int32_t id) override
+    {
+        PriceRecord record{id, real->price(id)};
+        std::lock_guard lock(mutex);
+        file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        return record.result;
+    };
+
+    RecordingPriceProvider(PriceService *real, const std::string &filename)
+        : real{real}, file{filename, std::ios::binary | std::ios::trunc} {};
+
+private:
+    PriceService *real;
+    std::mutex mutex;
+    std::ofstream file;
+};
+
+// Declare a service provider that replays recorded calls.
+// The whole recording is loaded in advance,
+// so there is no I/O while serving the calls.
+class ReplayPriceProvider : public PriceService
+{
+public:
+    virtual double price(std::int32_t id) override
+    {
+        assert((next < records.size()) && "Recording exhausted");
+        const PriceRecord &record = records[next++];
+        assert((record.id == id) && "Calls diverge from recording");
+        return record.result;
+    };
+
+    ReplayPriceProvider(const std::string &filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        PriceRecord record;
+        while (file.read(reinterpret_cast<char *>(&record), sizeof(record)))
+            records.push_back(record);
+    };
+
+private:
+    std::vector<PriceRecord> records;
+    std::size_t next = 0;
+};
+
+// Service consumer to be benchmarked in isolation
+void test(const std::string &msg)
+{
+    std::cout << msg << std::endl;
+    dip::instance<PriceService> prices;
+    for (std::int32_t id = 1; id <= 3; id++)
+        std::cout << "price(" << id << ") = " << prices->price(id) << std::endl;
+}
+
+int main()
+{
+    const std::string filename = "prices.bin";
+
+    // First demonstration: record the traffic of the real provider.
+    // A custom injector is used, so the recorder is closed
+    // (and the file flushed) when it goes out of scope.
+    {
+        RealPriceProvider real;
+        RecordingPriceProvider recorder(&real, filename);
+        dip::inject<PriceService>({.acquire = [&recorder]() -> PriceService *
+                                   { return &recorder; }});
+        test("== Recording ==");
+        dip::instance<PriceService>::clear_injection();
+    }
+
+    // Second demonstration: replay the same traffic
+    // with no cost or variance from the real provider
+    dip::inject_singleton<PriceService, ReplayPriceProvider>(filename);
+    test("== Replaying ==");
+}
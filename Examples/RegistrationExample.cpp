@@ -0,0 +1,77 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Utilities
+#include <iostream>
+#include <string>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service.
+class MyService
+{
+public:
+    virtual void foo() = 0;
+    virtual ~MyService() {};
+};
+
+// Declare a service provider.
+class MyServiceProvider1 : public MyService
+{
+public:
+    virtual void foo() override
+    {
+        std::cout << this << ".MyServiceProvider1::foo()" << std::endl;
+    };
+};
+
+// Declare another service provider having constructor parameters.
+class MyServiceProvider2 : public MyService
+{
+public:
+    virtual void foo() override
+    {
+        std::cout << this << ".MyServiceProvider2::foo(" << data << ")" << std::endl;
+    };
+
+    MyServiceProvider2(std::string param) : data{param} {};
+
+private:
+    std::string data;
+};
+
+// Register the dependency injections next to the service providers.
+// They could be distributed across many source files.
+// Lower priorities are injected first, so MyServiceProvider1
+// comes first in the set despite being registered last.
+// Equal priorities keep declaration order, so "first" comes
+// before "second".
+DIP_REGISTER_SET(MyService, MyServiceProvider2, transient, 20, "first");
+DIP_REGISTER_SET(MyService, MyServiceProvider2, transient, 20, "second");
+DIP_REGISTER_SET(MyService, MyServiceProvider1, singleton, 10);
+DIP_REGISTER(MyService, MyServiceProvider1, transient, 10);
+
+// Consume the service
+void test()
+{
+    dip::instance<MyService> instance;
+    instance->foo();
+
+    dip::instance_set<MyService> instance_set;
+    for (auto instance : instance_set)
+        instance->foo();
+}
+
+int main()
+{
+    // Inject all registered dependencies
+    dip::wire_registered();
+
+    // Consume
+    test();
+}
@@ -0,0 +1,187 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Note: POSIX only
+
+// Utilities
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service
+class PriceService
+{
+public:
+    virtual double price(std::int32_t id) = 0;
+    virtual ~PriceService() {};
+};
+
+// Declare the real service provider.
+// Let's pretend it is crash-prone or memory-hungry,
+// so it runs in a separate process.
+class RealPriceProvider : public PriceService
+{
+public:
+    virtual double price(std::int32_t id) override
+    {
+        return id * 1.5;
+    };
+};
+
+// Wire format: fixed-size binary messages
+struct PriceRequest
+{
+    std::int32_t id;
+};
+
+struct PriceResponse
+{
+    double result;
+};
+
+// Read or write a whole message
+static bool transfer(int fd, void *data, std::size_t size, bool writing)
+{
+    char *buffer = static_cast<char *>(data);
+    while (size > 0)
+    {
+        ssize_t count = writing ? write(fd, buffer, size) : read(fd, buffer, size);
+        if (count <= 0)
+            return false;
+        buffer += count;
+        size -= count;
+    }
+    return true;
+}
+
+// Server: serves the real service provider over a Unix domain socket.
+// Every connection is served in its own thread until the client closes it,
+// so many clients (one per consumer thread) are served at once.
+static void serve(const std::string &socket_path, int ready)
+{
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(socket_path.c_str());
+    if ((bind(listener, (sockaddr *)&address, sizeof(address)) < 0) ||
+        (listen(listener, 8) < 0))
+        _exit(1);
+    close(ready); // Tell the parent process we are listening
+
+    static RealPriceProvider provider;
+    int client;
+    while ((client = accept(listener, nullptr, nullptr)) >= 0)
+    {
+        std::thread(
+            [client]()
+            {
+                PriceRequest request;
+                while (transfer(client, &request, sizeof(request), false))
+                {
+                    PriceResponse response{provider.price(request.id)};
+                    if (!transfer(client, &response, sizeof(response), true))
+                        break;
+                }
+                close(client);
+            })
+            .detach();
+    }
+    _exit(0);
+}
+
+// Client stub: a service provider forwarding every call to the server.
+// Injected as a thread singleton, so every thread has its own connection
+// and no locking is needed.
+class RemotePriceService : public PriceService
+{
+public:
+    virtual double price(std::int32_t id) override
+    {
+        PriceRequest request{id};
+        PriceResponse response;
+        if (!transfer(fd, &request, sizeof(request), true) ||
+            !transfer(fd, &response, sizeof(response), false))
+            throw std::runtime_error("Remote service provider failed");
+        return response.result;
+    };
+
+    RemotePriceService(std::string socket_path)
+    {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, (sockaddr *)&address, sizeof(address)) < 0)
+        {
+            close(fd);
+            throw std::runtime_error("Unable to connect to " + socket_path);
+        }
+    };
+
+    ~RemotePriceService()
+    {
+        close(fd);
+    };
+
+private:
+    int fd;
+};
+
+// Service consumer: not aware of the remote service provider
+void test()
+{
+    dip::instance<PriceService> prices;
+    for (std::int32_t id = 1; id <= 3; id++)
+        std::cout << "price(" << id << ") = " << prices->price(id) << std::endl;
+}
+
+int main()
+{
+    const std::string socket_path = "/tmp/dip_price_service.sock";
+
+    // Start the server process (a stand-in for a sidecar)
+    // and wait for it to be listening
+    int ready[2];
+    if (pipe(ready) < 0)
+        return 1;
+    pid_t server = fork();
+    if (server == 0)
+    {
+        close(ready[0]);
+        serve(socket_path, ready[1]);
+    }
+    close(ready[1]);
+    char dummy;
+    (void)read(ready[0], &dummy, 1);
+    close(ready[0]);
+
+    // Inject the client stub
+    dip::inject_thread_singleton<PriceService, RemotePriceService>(socket_path);
+
+    // Consume from two threads, each one having its own connection
+    test();
+    std::thread([]()
+                { test(); })
+        .join();
+
+    // Stop the server
+    kill(server, SIGTERM);
+    waitpid(server, nullptr, 0);
+    unlink(socket_path.c_str());
+}
@@ -8,6 +8,7 @@
 // Utilities
 #include <iostream>
 #include <array>
+#include <atomic>
 
 // Import the framework
 #include "../dip.hpp"
@@ -67,18 +68,18 @@ struct RoundRobin
         }
     }
 
+    // Service consumers may run in different threads,
+    // so the round counter must be atomic
     static MyService *acquire()
     {
-        MyService *instance = providers[round];
-        round++;
-        if (round >= providers.size())
-            round = 0;
-        return instance;
+        std::size_t index =
+            round.fetch_add(1, std::memory_order_relaxed) % providers.size();
+        return providers[index];
     }
 
 private:
     inline static std::array<MyServiceProvider *, 3> providers;
-    inline static std::size_t round = 0;
+    inline static std::atomic<std::size_t> round = 0;
 };
 
 // Main program
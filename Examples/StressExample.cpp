@@ -0,0 +1,173 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Hammers every life cycle from 1..N threads,
+// checks the results and prints the throughput for each thread count.
+// Exits with a non-zero status if any check fails.
+//
+// Build it with -fsanitize=thread to catch data races, for example:
+//   g++ -std=c++20 -O1 -g -fsanitize=thread -pthread StressExample.cpp
+
+// Utilities
+#include <iostream>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service
+class MyService
+{
+public:
+    virtual void foo() = 0;
+    virtual ~MyService() {};
+};
+
+// Services are told apart by a tag, so each one
+// may be injected with a different life cycle
+template <int Tag>
+class TaggedService : public MyService
+{
+};
+
+typedef TaggedService<0> SingletonService;
+typedef TaggedService<1> ThreadSingletonService;
+typedef TaggedService<2> TransientService;
+typedef TaggedService<3> RoundRobinService;
+
+// Declare a service provider counting its calls
+template <class Service>
+class CountingProvider : public Service
+{
+public:
+    virtual void foo() override
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    CountingProvider() { alive.fetch_add(1, std::memory_order_relaxed); };
+    ~CountingProvider() { alive.fetch_sub(1, std::memory_order_relaxed); };
+
+    std::atomic<std::size_t> calls = 0;
+    inline static std::atomic<std::ptrdiff_t> alive = 0;
+};
+
+// Custom injector shared by all threads
+struct RoundRobin
+{
+    static RoundRobinService *acquire()
+    {
+        std::size_t index =
+            round.fetch_add(1, std::memory_order_relaxed) % providers.size();
+        return &providers[index];
+    }
+
+    inline static std::array<CountingProvider<RoundRobinService>, 4> providers;
+    inline static std::atomic<std::size_t> round = 0;
+};
+
+static std::atomic<int> failures = 0;
+
+static void expect(bool condition, const char *what)
+{
+    if (!condition)
+    {
+        failures++;
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+// Service consumer running in every thread
+static void consume(std::size_t iterations)
+{
+    MyService *own = nullptr;
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        {
+            dip::instance<SingletonService> singleton;
+            singleton->foo();
+        }
+        {
+            dip::instance<ThreadSingletonService> thread_singleton;
+            if (!own)
+                own = *thread_singleton;
+            expect(own == *thread_singleton, "thread singleton is not unique per thread");
+            thread_singleton->foo();
+        }
+        {
+            dip::instance<TransientService> transient;
+            transient->foo();
+        }
+        {
+            dip::instance<RoundRobinService> round_robin;
+            round_robin->foo();
+        }
+        {
+            dip::instance_set<MyService> set;
+            expect(set.size() == 2, "wrong instance_set size");
+            for (auto provider : set)
+                provider->foo();
+        }
+    }
+    auto counting = static_cast<CountingProvider<ThreadSingletonService> *>(own);
+    expect(counting->calls.load() == iterations, "thread singleton shared between threads");
+}
+
+int main()
+{
+    // Inject
+    dip::inject_singleton<SingletonService, CountingProvider<SingletonService>>();
+    dip::inject_thread_singleton<ThreadSingletonService, CountingProvider<ThreadSingletonService>>();
+    dip::inject_transient<TransientService, CountingProvider<TransientService>>();
+    dip::inject<RoundRobinService>({.acquire = RoundRobin::acquire});
+    dip::add_singleton<MyService, CountingProvider<SingletonService>>();
+    dip::add_transient<MyService, CountingProvider<TransientService>>();
+
+    // Singletons are constructed on first use
+    dip::instance<SingletonService> singleton;
+    auto shared = static_cast<CountingProvider<SingletonService> *>(*singleton);
+
+    const std::size_t iterations = 20000;
+    std::size_t max_threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    std::cout << "threads, acquisitions per second" << std::endl;
+    for (std::size_t threads = 1; threads <= max_threads; threads++)
+    {
+        std::size_t shared_calls = shared->calls.load();
+        std::size_t round = RoundRobin::round.load();
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> consumers;
+        for (std::size_t t = 0; t < threads; t++)
+            consumers.emplace_back(consume, iterations);
+        for (auto &consumer : consumers)
+            consumer.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // 4 single instances plus a set of 2 per iteration
+        double acquisitions = 6.0 * threads * iterations;
+        std::cout << threads << ", " << acquisitions / elapsed.count() << std::endl;
+
+        std::size_t total = threads * iterations;
+        expect(shared->calls.load() - shared_calls == total, "lost singleton calls");
+        expect(RoundRobin::round.load() - round == total, "lost round-robin acquisitions");
+        expect(CountingProvider<TransientService>::alive.load() == 0, "leaked transient providers");
+        expect(CountingProvider<ThreadSingletonService>::alive.load() == 0, "leaked thread singletons");
+    }
+
+    std::size_t round_robin_calls = 0;
+    for (auto &provider : RoundRobin::providers)
+        round_robin_calls += provider.calls.load();
+    expect(round_robin_calls == RoundRobin::round.load(), "lost round-robin calls");
+
+    std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+/*
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+// Benchmark of thread singletons under thread churn.
+// Threads are created and destroyed in rounds, as thread pools do under load.
+// Every thread constructs and destroys its own thread singleton.
+// Reports RSS growth, construction/destruction CPU time
+// and p99 acquisition latency against a singleton baseline.
+//
+// Note: RSS is read from /proc/self/statm (Linux only)
+
+// Utilities
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+
+// Import the framework
+#include "../dip.hpp"
+
+// Declare a service
+class MyService
+{
+public:
+    virtual std::uint64_t foo() = 0;
+    virtual ~MyService() {};
+};
+
+// Services are told apart by a tag, so each one
+// may be injected with a different life cycle
+template <int Tag>
+class TaggedService : public MyService
+{
+};
+
+typedef TaggedService<0> SingletonService;
+typedef TaggedService<1> ThreadSingletonService;
+
+// CPU time spent constructing and destroying service providers
+static std::atomic<std::uint64_t> construction_ns = 0;
+static std::atomic<std::uint64_t> destruction_ns = 0;
+static std::atomic<std::uint64_t> constructions = 0;
+
+static std::uint64_t thread_cpu_ns()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+// Declare a service provider having some per-instance state
+// (32 KiB), as a per-thread cache would
+template <class Service>
+class MyServiceProvider : public Service
+{
+public:
+    virtual std::uint64_t foo() override
+    {
+        return calls.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    MyServiceProvider()
+    {
+        std::uint64_t t0 = thread_cpu_ns();
+        state.assign(4096, 0);
+        construction_ns += thread_cpu_ns() - t0;
+        constructions++;
+    };
+
+    ~MyServiceProvider()
+    {
+        std::uint64_t t0 = thread_cpu_ns();
+        state.clear();
+        state.shrink_to_fit();
+        destruction_ns += thread_cpu_ns() - t0;
+    };
+
+private:
+    std::vector<std::uint64_t> state;
+    std::atomic<std::uint64_t> calls = 0;
+};
+
+// Resident set size in KiB
+static std::size_t rss_kib()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Create and destroy threads consuming a service
+template <class Service>
+void churn(std::size_t rounds, std::size_t threads, std::size_t acquisitions)
+{
+    std::atomic<std::uint64_t> sink = 0;
+    for (std::size_t round = 0; round < rounds; round++)
+    {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; t++)
+            workers.emplace_back(
+                [&]()
+                {
+                    std::uint64_t sum = 0;
+                    for (std::size_t i = 0; i < acquisitions; i++)
+                    {
+                        dip::instance<Service> provider;
+                        sum += provider->foo();
+                    }
+                    sink += sum;
+                });
+        for (auto &worker : workers)
+            worker.join();
+    }
+}
+
+// Run the benchmark for a service and print the results
+template <class Service>
+void report(const char *name, std::size_t rounds, std::size_t threads, std::size_t acquisitions)
+{
+    dip::acquisition_histogram<Service>::reset();
+    construction_ns = 0;
+    destruction_ns = 0;
+    constructions = 0;
+    std::size_t rss_before = rss_kib();
+    auto t0 = std::chrono::steady_clock::now();
+    churn<Service>(rounds, threads, acquisitions);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - t0;
+    std::size_t rss_after = rss_kib();
+
+    std::cout << name << std::endl;
+    std::cout << "  threads created:       " << rounds * threads << std::endl;
+    std::cout << "  elapsed:               " << elapsed.count() << " ms" << std::endl;
+    std::cout << "  RSS growth:            " << (long)rss_after - (long)rss_before << " KiB" << std::endl;
+    std::cout << "  providers constructed: " << constructions.load() << std::endl;
+    std::cout << "  construction CPU:      " << construction_ns.load() / 1000 << " us" << std::endl;
+    std::cout << "  destruction CPU:       " << destruction_ns.load() / 1000 << " us" << std::endl;
+    std::cout << "  p50 acquisition:       <= "
+              << dip::acquisition_histogram<Service>::percentile(0.5) << " ns" << std::endl;
+    std::cout << "  p99 acquisition:       <= "
+              << dip::acquisition_histogram<Service>::percentile(0.99) << " ns" << std::endl;
+    std::cout << "  p99.9 acquisition:     <= "
+              << dip::acquisition_histogram<Service>::percentile(0.999) << " ns" << std::endl;
+}
+
+int main()
+{
+    // Inject
+    dip::inject_singleton<SingletonService, MyServiceProvider<SingletonService>>();
+    dip::inject_thread_singleton<ThreadSingletonService, MyServiceProvider<ThreadSingletonService>>();
+
+    // Time every acquisition
+    dip::sample_acquisitions<SingletonService>(1);
+    dip::sample_acquisitions<ThreadSingletonService>(1);
+
+    const std::size_t rounds = 200;
+    const std::size_t threads = 8;
+    const std::size_t acquisitions = 1000;
+
+    // Warm up, so the baseline does not include process-wide allocations
+    churn<SingletonService>(10, threads, acquisitions);
+
+    // Singletons are shared by all threads: the baseline
+    report<SingletonService>("singleton (baseline)", rounds, threads, acquisitions);
+    report<ThreadSingletonService>("thread singleton", rounds, threads, acquisitions);
+}
@@ -18,6 +18,29 @@
 #include <cassert>
 #include <functional>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 // #include <iostream> // For testing
 
@@ -30,37 +53,916 @@ namespace dip
     /**
      * @brief Custom injector
      *
-     * @tparam Service Service to be injected
+     * @tparam Service Service to be injected
+     */
+    template <class Service>
+    struct Injector
+    {
+        /**
+         * @brief Type of a function able to retrieve instances
+         *
+         */
+        typedef std::function<Service *()> AcquireFunction;
+
+        /**
+         * @brief Type of a function able to remove unneeded instances
+         *
+         */
+        typedef std::function<void(Service *)> ReleaseFunction;
+
+        /**
+         * @brief Custom function to retrieve instances
+         *
+         * @note Mandatory. Must return non-null.
+         */
+        AcquireFunction acquire;
+
+        /**
+         * @brief Custom function to remove uneeded instances
+         *
+         * @note Optional
+         */
+        ReleaseFunction release;
+    };
+
+    /**
+     * @brief Low-overhead time stamp counter
+     *
+     * @note Uses the processor's time stamp counter when available
+     *       (x86), otherwise falls back to std::chrono::steady_clock.
+     */
+    struct tsc
+    {
+        /**
+         * @brief Read the time stamp counter
+         *
+         * @note On x86, fenced on both sides, so the read is not
+         *       reordered with the code being measured.
+         *
+         * @return std::uint64_t Ticks
+         */
+        static std::uint64_t now() noexcept
+        {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_ia32_lfence();
+            std::uint64_t ticks = __builtin_ia32_rdtsc();
+            __builtin_ia32_lfence();
+            return ticks;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_lfence();
+            std::uint64_t ticks = __rdtsc();
+            _mm_lfence();
+            return ticks;
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+#endif
+        }
+
+        /**
+         * @brief Get the calibrated duration of a tick
+         *
+         * @note Calibrated against std::chrono::steady_clock on first call.
+         *
+         * @return double Nanoseconds per tick
+         */
+        static double ns_per_tick() noexcept
+        {
+            static const double ratio = calibrate();
+            return ratio;
+        }
+
+        /**
+         * @brief Convert ticks to nanoseconds
+         *
+         * @param ticks Tick count
+         * @return std::uint64_t Nanoseconds
+         */
+        static std::uint64_t to_ns(std::uint64_t ticks) noexcept
+        {
+            return static_cast<std::uint64_t>(ticks * ns_per_tick());
+        }
+
+    private:
+        static double calibrate() noexcept
+        {
+            using clock = std::chrono::steady_clock;
+            auto t0 = clock::now();
+            auto c0 = now();
+            while (clock::now() - t0 < std::chrono::milliseconds(10))
+                ;
+            auto c1 = now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - t0);
+            return (c1 > c0)
+                       ? static_cast<double>(elapsed.count()) / (c1 - c0)
+                       : 1.0;
+        }
+    }; // struct tsc
+
+    /**
+     * @brief Histogram of sampled acquisition times of a service
+     *
+     * @note Bucket `i` counts samples lasting less than `2^i` nanoseconds
+     *       and no less than `2^(i-1)` nanoseconds.
+     *
+     * @tparam Service Injectable service
+     */
+    template <class Service>
+    struct acquisition_histogram
+    {
+        /// @brief Count of buckets
+        static constexpr std::size_t buckets = 65;
+
+        /**
+         * @brief Record a sample
+         *
+         * @param ns Acquisition time in nanoseconds
+         */
+        static void record(std::uint64_t ns) noexcept
+        {
+            _counts[std::bit_width(ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the count of samples in a bucket
+         *
+         * @param bucket Bucket index
+         * @return std::uint64_t Count of samples
+         */
+        static std::uint64_t count(std::size_t bucket) noexcept
+        {
+            return _counts[bucket].load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the total count of samples
+         *
+         * @return std::uint64_t Count of samples
+         */
+        static std::uint64_t samples() noexcept
+        {
+            std::uint64_t total = 0;
+            for (std::size_t i = 0; i < buckets; i++)
+                total += count(i);
+            return total;
+        }
+
+        /**
+         * @brief Get an upper bound of a percentile
+         *
+         * @param q Quantile in the range [0,1]
+         * @return std::uint64_t Upper bound in nanoseconds
+         */
+        static std::uint64_t percentile(double q) noexcept
+        {
+            std::uint64_t total = samples();
+            std::uint64_t accumulated = 0;
+            for (std::size_t i = 0; i < buckets; i++)
+            {
+                accumulated += count(i);
+                if ((accumulated > 0) && (accumulated >= q * total))
+                    return (i < 64) ? (std::uint64_t{1} << i) : UINT64_MAX;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Discard all samples
+         *
+         */
+        static void reset() noexcept
+        {
+            for (auto &counter : _counts)
+                counter.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        inline static std::array<std::atomic<std::uint64_t>, buckets> _counts{};
+    }; // struct acquisition_histogram
+
+    /**
+     * @brief Latency-critical region of a thread
+     *
+     * @note While an instance of this class is alive, acquiring a service
+     *       provider that allocates, blocks or constructs is a violation:
+     *       transient life cycles, first-time construction of singletons
+     *       and thread singletons, and dip::instance_set.
+     *       Violations are counted and trigger an assertion.
+     *       Custom injectors may call check() to enforce the same policy.
+     */
+    struct realtime_scope
+    {
+        /**
+         * @brief Enter a latency-critical region in the calling thread
+         *
+         */
+        realtime_scope() noexcept { _depth++; }
+
+        /**
+         * @brief Leave the latency-critical region
+         *
+         */
+        ~realtime_scope() noexcept { _depth--; }
+
+        realtime_scope(const realtime_scope &) = delete;
+        realtime_scope(realtime_scope &&) = delete;
+        realtime_scope &operator=(const realtime_scope &) = delete;
+        realtime_scope &operator=(realtime_scope &&) = delete;
+
+        /**
+         * @brief Check if the calling thread is in a latency-critical region
+         *
+         * @return true If in a latency-critical region
+         * @return false Otherwise
+         */
+        static bool active() noexcept { return _depth > 0; }
+
+        /**
+         * @brief Report a potentially allocating, blocking or
+         *        constructing operation
+         *
+         * @note Counts a violation if the calling thread is in a
+         *       latency-critical region.
+         *
+         * @return true Always
+         */
+        static bool check() noexcept
+        {
+            if (_depth > 0) [[unlikely]]
+            {
+                _violations.fetch_add(1, std::memory_order_relaxed);
+                assert(false && "Non real-time service acquisition in a realtime_scope");
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get the count of violations in all threads
+         *
+         * @return std::uint64_t Count of violations
+         */
+        static std::uint64_t violations() noexcept
+        {
+            return _violations.load(std::memory_order_relaxed);
+        }
+
+    private:
+        inline static thread_local std::size_t _depth = 0;
+        inline static std::atomic<std::uint64_t> _violations = 0;
+    }; // struct realtime_scope
+
+    /**
+     * @brief Hot service trait
+     *
+     * @note Specialize as std::true_type to declare a service as hot
+     *       (used in latency-critical paths).
+     *       Injecting a hot service with an allocating life cycle
+     *       (transient) will not compile.
+     *
+     * @tparam Service Injectable service
+     */
+    template <class Service>
+    struct hot : std::false_type
+    {
+    };
+
+    /**
+     * @brief Wiring manifest entry
+     *
+     * @note Never defined by this framework. Defined for every service
+     *       having a dependency injection by DIP_WIRED() or DIP_REGISTER(),
+     *       in the wiring code.
+     *       If DIP_WIRING_MANIFEST is defined, every dip::instance<Service>
+     *       refers to it, so consuming a service with no binding
+     *       will not link.
+     *
+     * @tparam Service Injectable service
+     */
+    template <class Service>
+    void wired();
+
+    /**
+     * @brief Contiguous storage for singletons
+     *
+     * @note Singletons injected with an arena life cycle are placed
+     *       one after another in a single memory block, in order of
+     *       construction. Since dependencies are constructed while
+     *       constructing their consumers, related singletons share
+     *       cache lines and TLB entries. Acquire singletons at startup
+     *       in the desired order to choose the layout.
+     *       Backed by huge pages where available (Linux).
+     *       If the arena is not reserved or exhausted,
+     *       singletons are allocated in the heap.
+     */
+    struct singleton_arena
+    {
+        /// @brief Alignment of the arena (huge page size)
+        static constexpr std::size_t alignment = 2 * 1024 * 1024;
+
+        /**
+         * @brief Reserve the arena
+         *
+         * @warning Call once at program startup, before any
+         *          singleton having an arena life cycle is acquired.
+         *          The arena is never released.
+         *
+         * @param bytes Arena size in bytes
+         */
+        static void reserve(std::size_t bytes)
+        {
+            assert((_begin == nullptr) && "Arena already reserved");
+            bytes = ((bytes + alignment - 1) / alignment) * alignment;
+            _begin = static_cast<char *>(
+                ::operator new(bytes, std::align_val_t{alignment}));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            madvise(_begin, bytes, MADV_HUGEPAGE);
+#endif
+            _end = _begin + bytes;
+            _next.store(_begin, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the count of bytes in use
+         *
+         * @return std::size_t Bytes in use
+         */
+        static std::size_t used() noexcept
+        {
+            return _begin ? (_next.load(std::memory_order_relaxed) - _begin) : 0;
+        }
+
+        /**
+         * @brief Singleton placed in the arena
+         *
+         * @tparam Provider Service provider
+         */
+        template <class Provider>
+        struct slot
+        {
+            /**
+             * @brief Construct the singleton
+             *
+             * @tparam _Args Constructor argument types
+             * @param args Constructor arguments
+             */
+            template <typename... _Args>
+            slot(_Args &&...args)
+            {
+                void *memory = allocate(sizeof(Provider), alignof(Provider));
+                if (memory)
+                    _provider = new (memory) Provider(std::forward<_Args>(args)...);
+                else
+                    _provider = new Provider(std::forward<_Args>(args)...);
+            }
+
+            /**
+             * @brief Destroy the singleton
+             *
+             */
+            ~slot() noexcept
+            {
+                char *address = reinterpret_cast<char *>(_provider);
+                if ((address >= _begin) && (address < _end))
+                    _provider->~Provider();
+                else
+                    delete _provider;
+            }
+
+            slot(const slot &) = delete;
+            slot(slot &&) = delete;
+            slot &operator=(const slot &) = delete;
+            slot &operator=(slot &&) = delete;
+
+            /**
+             * @brief Get the singleton
+             *
+             * @return Provider* Singleton
+             */
+            Provider *get() const noexcept { return _provider; }
+
+        private:
+            Provider *_provider;
+        }; // struct slot
+
+    private:
+        static void *allocate(std::size_t size, std::size_t align) noexcept
+        {
+            char *current = _next.load(std::memory_order_relaxed);
+            while (current)
+            {
+                std::uintptr_t address = reinterpret_cast<std::uintptr_t>(current);
+                address = (address + align - 1) & ~(std::uintptr_t{align} - 1);
+                char *result = reinterpret_cast<char *>(address);
+                if (result + size > _end)
+                    return nullptr;
+                if (_next.compare_exchange_weak(
+                        current,
+                        result + size,
+                        std::memory_order_relaxed))
+                    return result;
+            }
+            return nullptr;
+        }
+
+        inline static char *_begin = nullptr;
+        inline static char *_end = nullptr;
+        inline static std::atomic<char *> _next = nullptr;
+    }; // struct singleton_arena
+
+    /**
+     * @brief Binary output of a checkpoint section
+     *
+     */
+    class checkpoint_writer
+    {
+    public:
+        /**
+         * @brief Write raw bytes
+         *
+         * @param data Bytes
+         * @param size Count of bytes
+         */
+        void write(const void *data, std::size_t size)
+        {
+            _buffer.append(static_cast<const char *>(data), size);
+        }
+
+        /**
+         * @brief Write a trivially copyable value
+         *
+         * @tparam T Type of the value
+         * @param value Value
+         */
+        template <class T>
+        void write(const T &value)
+        {
+            static_assert(
+                std::is_trivially_copyable<T>::value,
+                "Only trivially copyable values can be written");
+            write(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Write a string
+         *
+         * @param value String
+         */
+        void write(const std::string &value)
+        {
+            write(static_cast<std::uint64_t>(value.size()));
+            write(value.data(), value.size());
+        }
+
+    private:
+        friend struct checkpoint;
+        std::string _buffer;
+    }; // class checkpoint_writer
+
+    /**
+     * @brief Binary input of a checkpoint section
+     *
+     */
+    class checkpoint_reader
+    {
+    public:
+        /**
+         * @brief Create a reader
+         *
+         * @param data Bytes
+         * @param size Count of bytes
+         */
+        checkpoint_reader(const char *data, std::size_t size) noexcept
+            : _next{data}, _end{data + size} {}
+
+        /**
+         * @brief Read raw bytes
+         *
+         * @param data Buffer
+         * @param size Count of bytes
+         * @return true On success
+         * @return false If there are not enough bytes
+         */
+        bool read(void *data, std::size_t size) noexcept
+        {
+            if (static_cast<std::size_t>(_end - _next) < size)
+                return false;
+            std::memcpy(data, _next, size);
+            _next += size;
+            return true;
+        }
+
+        /**
+         * @brief Read a trivially copyable value
+         *
+         * @tparam T Type of the value
+         * @param value Value
+         * @return true On success
+         * @return false If there are not enough bytes
+         */
+        template <class T>
+        bool read(T &value) noexcept
+        {
+            static_assert(
+                std::is_trivially_copyable<T>::value,
+                "Only trivially copyable values can be read");
+            return read(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Read a string
+         *
+         * @param value String
+         * @return true On success
+         * @return false If there are not enough bytes
+         */
+        bool read(std::string &value)
+        {
+            std::uint64_t size;
+            if (!read(size) || (static_cast<std::uint64_t>(_end - _next) < size))
+                return false;
+            value.assign(_next, size);
+            _next += size;
+            return true;
+        }
+
+        /**
+         * @brief Check if all bytes were read
+         *
+         * @return true If all bytes were read
+         * @return false Otherwise
+         */
+        bool exhausted() const noexcept { return _next == _end; }
+
+    private:
+        friend struct checkpoint;
+        const char *_next;
+        const char *_end;
+    }; // class checkpoint_reader
+
+    /**
+     * @brief Service provider able to save and restore its state
+     *
+     * @note `load()` must validate the data before changing any state
+     *       and return false if the data is not valid.
+     *
+     * @tparam Provider Service provider
+     */
+    template <class Provider>
+    concept checkpointable = requires(
+        const Provider &provider,
+        Provider &target,
+        checkpoint_writer &writer,
+        checkpoint_reader &reader) {
+        provider.save(writer);
+        { target.load(reader) } -> std::convertible_to<bool>;
+    };
+
+    /**
+     * @brief Checkpoint of the state of singletons
+     *
+     * @note Singletons whose service provider is dip::checkpointable
+     *       are restored from the checkpoint right after construction.
+     *       If there is no checkpoint, or it does not match the format
+     *       or version, singletons are built as usual.
+     */
+    struct checkpoint
+    {
+        /**
+         * @brief Load a checkpoint file
+         *
+         * @warning Call at program startup, before any singleton is acquired.
+         *
+         * @param path File name
+         * @param version Application-defined version of the saved state
+         * @return true If the checkpoint was loaded
+         * @return false If missing, corrupted or mismatching
+         */
+        static bool restore(const std::string &path, std::uint32_t version)
+        {
+            std::lock_guard lock(_mutex);
+            _sections.clear();
+            _data.clear();
+            if (std::FILE *file = std::fopen(path.c_str(), "rb"))
+            {
+                char buffer[4096];
+                std::size_t size;
+                while ((size = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+                    _data.append(buffer, size);
+                std::fclose(file);
+            }
+            checkpoint_reader reader(_data.data(), _data.size());
+            char magic[sizeof(_magic)];
+            std::uint32_t format, saved_version, count;
+            bool valid =
+                reader.read(magic, sizeof(magic)) &&
+                (std::memcmp(magic, _magic, sizeof(magic)) == 0) &&
+                reader.read(format) && (format == _format) &&
+                reader.read(saved_version) && (saved_version == version) &&
+                reader.read(count);
+            for (std::uint32_t i = 0; valid && (i < count); i++)
+            {
+                std::string key;
+                std::uint64_t size;
+                valid = reader.read(key) && reader.read(size) &&
+                        (static_cast<std::uint64_t>(reader._end - reader._next) >= size);
+                if (valid)
+                {
+                    _sections[key] = {
+                        static_cast<std::size_t>(reader._next - _data.data()),
+                        static_cast<std::size_t>(size)};
+                    reader._next += size;
+                }
+            }
+            if (!valid)
+            {
+                _sections.clear();
+                _data.clear();
+            }
+            return valid;
+        }
+
+        /**
+         * @brief Save the state of all live checkpointable singletons
+         *
+         * @note The file is replaced atomically
+         *
+         * @warning Call at program shutdown, while singletons are alive.
+         *
+         * @param path File name
+         * @param version Application-defined version of the saved state
+         * @return true On success
+         * @return false On I/O error
+         */
+        static bool save(const std::string &path, std::uint32_t version)
+        {
+            std::lock_guard lock(_mutex);
+            checkpoint_writer writer;
+            writer.write(_magic, sizeof(_magic));
+            writer.write(_format);
+            writer.write(version);
+            writer.write(static_cast<std::uint32_t>(_live.size()));
+            for (auto &singleton : _live)
+            {
+                checkpoint_writer section;
+                singleton.save(section);
+                writer.write(singleton.key);
+                writer.write(static_cast<std::uint64_t>(section._buffer.size()));
+                writer.write(section._buffer.data(), section._buffer.size());
+            }
+            std::string temporary = path + ".tmp";
+            std::FILE *file = std::fopen(temporary.c_str(), "wb");
+            if (!file)
+                return false;
+            bool written =
+                (std::fwrite(writer._buffer.data(), 1, writer._buffer.size(), file) ==
+                 writer._buffer.size());
+            if ((std::fclose(file) != 0) || !written)
+                return false;
+            return std::rename(temporary.c_str(), path.c_str()) == 0;
+        }
+
+        /**
+         * @brief Restore a singleton and track it for saving
+         *
+         * @note Called by the predefined singleton life cycles
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @param provider Singleton
+         * @param kind Life cycle (to tell apart singletons of the same type)
+         * @return true Always
+         */
+        template <class Service, class Provider>
+        static bool attach(Provider &provider, const char *kind)
+        {
+            std::string key = std::string(kind) + ":" +
+                              typeid(Service).name() + ":" +
+                              typeid(Provider).name();
+            std::lock_guard lock(_mutex);
+            auto found = _sections.find(key);
+            if (found != _sections.end())
+            {
+                checkpoint_reader reader(
+                    _data.data() + found->second.first,
+                    found->second.second);
+                provider.load(reader);
+            }
+            _live.push_back(
+                {key,
+                 [&provider](checkpoint_writer &writer)
+                 { provider.save(writer); }});
+            return true;
+        }
+
+    private:
+        struct live_singleton
+        {
+            std::string key;
+            std::function<void(checkpoint_writer &)> save;
+        };
+
+        static constexpr char _magic[8] = {'D', 'I', 'P', 'C', 'K', 'P', 'T', '\0'};
+        static constexpr std::uint32_t _format = 1;
+        inline static std::mutex _mutex;
+        inline static std::string _data;
+        inline static std::unordered_map<std::string, std::pair<std::size_t, std::size_t>> _sections;
+        inline static std::vector<live_singleton> _live;
+    }; // struct checkpoint
+
+    template <class Service>
+    struct instance;
+
+    /**
+     * @brief Pin of one generation of dependency injections
+     *
+     * @note Dependency injections may be replaced at runtime
+     *       using dip::rebind(). Replacements are staged until
+     *       snapshot::publish() is called, which makes all of them
+     *       visible at once as a new generation.
+     *       While a snapshot is alive, every dip::instance<Service>
+     *       declared in the same thread resolves to the generation
+     *       that was current when the snapshot was created,
+     *       so a request never mixes old and new service providers.
+     *       Superseded injectors are destroyed when no snapshot
+     *       pins them (epoch-based reclamation).
+     *       Creating a snapshot and resolving within it are wait-free,
+     *       except for the first pin in each thread, which may allocate
+     *       a per-thread record (lock-free). Pin once at thread startup
+     *       to keep it out of latency-critical code.
+     *       Nested snapshots share the outermost pin.
+     *       Outside a snapshot, an instance of a rebound service
+     *       pins the current generation for its own lifetime.
+     *
+     * @warning Instances declared within a snapshot must be destroyed
+     *          before the snapshot.
      */
-    template <class Service>
-    struct Injector
+    struct snapshot
     {
         /**
-         * @brief Type of a function able to retrieve instances
+         * @brief Pin the current generation in the calling thread
          *
          */
-        typedef std::function<Service *()> AcquireFunction;
+        snapshot() noexcept { enter(); }
 
         /**
-         * @brief Type of a function able to remove unneeded instances
+         * @brief Release the pin
          *
          */
-        typedef std::function<void(Service *)> ReleaseFunction;
+        ~snapshot() noexcept { leave(); }
+
+        snapshot(const snapshot &) = delete;
+        snapshot(snapshot &&) = delete;
+        snapshot &operator=(const snapshot &) = delete;
+        snapshot &operator=(snapshot &&) = delete;
 
         /**
-         * @brief Custom function to retrieve instances
+         * @brief Get the pinned generation
          *
-         * @note Mandatory. Must return non-null.
+         * @return std::uint64_t Generation
          */
-        AcquireFunction acquire;
+        std::uint64_t generation() const noexcept { return pinned(); }
 
         /**
-         * @brief Custom function to remove uneeded instances
+         * @brief Get the generation pinned by the calling thread
          *
-         * @note Optional
+         * @return std::uint64_t Generation, or zero if no snapshot is alive
          */
-        ReleaseFunction release;
-    };
+        static std::uint64_t pinned() noexcept
+        {
+            return _local ? _local->pinned.load(std::memory_order_relaxed) : 0;
+        }
+
+        /**
+         * @brief Get the current generation
+         *
+         * @return std::uint64_t Generation
+         */
+        static std::uint64_t current() noexcept
+        {
+            return _current.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Make all staged dependency injections visible
+         *        and reclaim unpinned generations
+         *
+         * @return std::uint64_t New generation
+         */
+        static std::uint64_t publish()
+        {
+            std::lock_guard lock(_writer);
+            std::uint64_t generation =
+                _current.fetch_add(1, std::memory_order_seq_cst) + 1;
+            reclaim();
+            return generation;
+        }
+
+        /**
+         * @brief Reclaim unpinned generations
+         *
+         * @note Also called by publish()
+         */
+        static void collect()
+        {
+            std::lock_guard lock(_writer);
+            reclaim();
+        }
+
+    private:
+        template <class>
+        friend struct instance;
+
+        /// @brief Type of a function reclaiming generations older than given
+        typedef void (*ReclaimFunction)(std::uint64_t oldest);
+
+        /// @brief Per-thread pin
+        struct record
+        {
+            std::atomic<std::uint64_t> pinned = 0;
+            std::atomic<bool> in_use = true;
+            std::size_t depth = 0;
+            record *next = nullptr;
+        };
+
+        /// @brief Releases the record of a thread when it exits
+        struct owner
+        {
+            ~owner() noexcept
+            {
+                if (_local)
+                    _local->in_use.store(false, std::memory_order_release);
+            }
+        };
+
+        static void enter() noexcept
+        {
+            record &own = local();
+            if (own.depth++ == 0)
+            {
+                // Block reclamation while reading the current generation
+                own.pinned.store(1, std::memory_order_seq_cst);
+                std::uint64_t generation = _current.load(std::memory_order_seq_cst);
+                own.pinned.store(generation, std::memory_order_seq_cst);
+            }
+        }
+
+        static void leave() noexcept
+        {
+            record &own = local();
+            if (--own.depth == 0)
+                own.pinned.store(0, std::memory_order_release);
+        }
+
+        static record &local() noexcept
+        {
+            static thread_local owner releaser;
+            if (!_local)
+            {
+                for (record *r = _records.load(std::memory_order_acquire); r; r = r->next)
+                {
+                    bool free = false;
+                    if (r->in_use.compare_exchange_strong(free, true))
+                    {
+                        _local = r;
+                        return *r;
+                    }
+                }
+                realtime_scope::check();
+                record *r = new record;
+                r->next = _records.load(std::memory_order_relaxed);
+                while (!_records.compare_exchange_weak(r->next, r))
+                    ;
+                _local = r;
+            }
+            return *_local;
+        }
+
+        static void reclaim()
+        {
+            std::uint64_t oldest = _current.load(std::memory_order_seq_cst);
+            for (record *r = _records.load(std::memory_order_acquire); r; r = r->next)
+            {
+                std::uint64_t generation = r->pinned.load(std::memory_order_seq_cst);
+                if ((generation != 0) && (generation < oldest))
+                    oldest = generation;
+            }
+            for (auto reclaimer : _reclaimers)
+                reclaimer(oldest);
+        }
+
+        static void enroll(ReclaimFunction reclaimer)
+        {
+            _reclaimers.push_back(reclaimer);
+        }
+
+        inline static std::atomic<std::uint64_t> _current = 1;
+        inline static std::atomic<record *> _records = nullptr;
+        inline static thread_local record *_local = nullptr;
+        inline static std::mutex _writer;
+        inline static std::vector<ReclaimFunction> _reclaimers;
+    }; // struct snapshot
 
     /**
      * @brief Injected instance of a service
@@ -89,8 +991,27 @@ namespace dip
          */
         instance()
         {
-            assert(_injector.acquire && "Missing dependency injection");
-            _instance = _injector.acquire();
+#ifdef DIP_WIRING_MANIFEST
+            static_cast<void>(_wired);
+#endif
+            if (_history.load(std::memory_order_acquire)) [[unlikely]]
+            {
+                // Pin for the lifetime of this instance,
+                // so the binding is not reclaimed while in use
+                snapshot::enter();
+                _pinned = true;
+                std::uint64_t generation = snapshot::pinned();
+                const binding *node = _history.load(std::memory_order_acquire);
+                while (node && (node->generation > generation))
+                    node = node->previous.load(std::memory_order_acquire);
+                if (node)
+                    _binding = &node->injector;
+            }
+            assert(_binding->acquire && "Missing dependency injection");
+            if (_sampling_period) [[unlikely]]
+                _instance = sampled_acquire();
+            else
+                _instance = _binding->acquire();
             assert(_instance && "An injector retrieved a null provider");
         }
 
@@ -100,8 +1021,10 @@ namespace dip
          */
         ~instance() noexcept
         {
-            if (_injector.release)
-                _injector.release(_instance);
+            if (_binding->release)
+                _binding->release(_instance);
+            if (_pinned)
+                snapshot::leave();
         }
 
         /**
@@ -130,6 +1053,9 @@ namespace dip
         /**
          * @brief Inject a service provider using a custom injector
          *
+         * @warning Not thread-safe. Must not run concurrently with
+         *          other injections or service consumers.
+         *
          * @param injector Service injector
          */
         static void inject(const Injector<Service> &injector) noexcept
@@ -162,7 +1088,13 @@ namespace dip
             _injector.release = nullptr;
             _injector.acquire = [... args = std::forward<_Args>(__args)]() -> Service *
             {
+                [[maybe_unused]] static bool constructing = realtime_scope::check();
                 static Provider p(args...);
+                if constexpr (checkpointable<Provider>)
+                {
+                    [[maybe_unused]] static bool restored =
+                        checkpoint::attach<Service>(p, "singleton");
+                }
                 return &p;
             };
         }
@@ -187,11 +1119,45 @@ namespace dip
             _injector.release = nullptr;
             _injector.acquire = [... args = std::forward<_Args>(__args)]() -> Service *
             {
+                [[maybe_unused]] static thread_local bool constructing =
+                    realtime_scope::check();
                 static thread_local Provider p(args...);
                 return &p;
             };
         }
 
+        /**
+         * @brief Inject a service provider with singleton life cycle
+         *        placed in the singleton arena
+         *
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor parameter types
+         * @param __args Constructor parameters
+         */
+        template <class Provider, typename... _Args>
+        static void inject_arena_singleton(_Args &&...__args)
+        {
+            static_assert(
+                std::is_base_of<Service, Provider>::value,
+                "Provider does not implement Service");
+            assert(
+                (_injector.acquire == nullptr) &&
+                (_injector.release == nullptr) &&
+                "Dependency already injected");
+            _injector.release = nullptr;
+            _injector.acquire = [... args = std::forward<_Args>(__args)]() -> Service *
+            {
+                [[maybe_unused]] static bool constructing = realtime_scope::check();
+                static singleton_arena::slot<Provider> p(args...);
+                if constexpr (checkpointable<Provider>)
+                {
+                    [[maybe_unused]] static bool restored =
+                        checkpoint::attach<Service>(*p.get(), "arena_singleton");
+                }
+                return p.get();
+            };
+        }
+
         /**
          * @brief Inject a service provider with transient life cycle
          *
@@ -202,6 +1168,9 @@ namespace dip
         template <class Provider, typename... _Args>
         static void inject_transient(_Args &&...__args)
         {
+            static_assert(
+                !hot<Service>::value,
+                "A hot service cannot have a transient life cycle");
             static_assert(
                 std::is_base_of<Service, Provider>::value,
                 "Provider does not implement Service");
@@ -212,14 +1181,37 @@ namespace dip
             _injector.acquire =
                 [... args = std::forward<_Args>(__args)]() -> Service *
             {
+                realtime_scope::check();
                 return new Provider(args...);
             };
             _injector.release = [](Service *provider) -> void
             {
+                realtime_scope::check();
                 delete provider;
             };
         }
 
+        /**
+         * @brief Sample the acquisition time of the injected service provider
+         *
+         * @note One out of @p period acquisitions per thread is timed
+         *       and recorded into dip::acquisition_histogram<Service>.
+         *       Unsampled acquisitions cost a thread-local decrement
+         *       and one branch on top of the acquisition itself.
+         *       While sampling is disabled, acquisitions cost one
+         *       well-predicted branch.
+         *
+         * @warning Call at program startup.
+         *
+         * @param period Sampling period, or zero to disable sampling
+         */
+        static void sample_acquisitions(std::uint32_t period)
+        {
+            if (period)
+                tsc::ns_per_tick();
+            _sampling_period = period;
+        }
+
         /**
          * @brief Clear the injected dependency for testing purposes
          *
@@ -231,13 +1223,103 @@ namespace dip
         {
             _injector.acquire = nullptr;
             _injector.release = nullptr;
+            _sampling_period = 0;
+            reclaim(UINT64_MAX);
+            delete _history.exchange(nullptr);
+        }
+
+        /**
+         * @brief Replace the injected service provider at runtime
+         *
+         * @note The replacement is staged until dip::snapshot::publish()
+         *       is called. The previous injector is destroyed
+         *       when no dip::snapshot pins it.
+         *
+         * @param injector Service injector
+         */
+        static void rebind(const Injector<Service> &injector)
+        {
+            assert(injector.acquire && "Invalid injector");
+            std::lock_guard lock(snapshot::_writer);
+            const binding *head = _history.load(std::memory_order_relaxed);
+            if (!head && !_enrolled)
+            {
+                snapshot::enroll(&instance::reclaim);
+                _enrolled = true;
+            }
+            binding *node = new binding{
+                injector,
+                snapshot::_current.load(std::memory_order_relaxed) + 1,
+                head};
+            _history.store(node, std::memory_order_release);
         }
 
     private:
+        /// @brief Acquire a service provider, timing one out of
+        ///        _sampling_period acquisitions per thread
+        service_type sampled_acquire()
+        {
+            if (_sampling_countdown--)
+                return _binding->acquire();
+            _sampling_countdown = _sampling_period - 1;
+            auto t0 = tsc::now();
+            service_type result = _binding->acquire();
+            auto t1 = tsc::now();
+            acquisition_histogram<Service>::record(tsc::to_ns(t1 - t0));
+            return result;
+        }
+
+        /// @brief Injector of a generation
+        struct binding
+        {
+            binding(
+                const Injector<Service> &injector,
+                std::uint64_t generation,
+                const binding *previous)
+                : injector{injector}, generation{generation}, previous{previous}
+            {
+            }
+
+            ~binding() noexcept
+            {
+                delete previous.load(std::memory_order_relaxed);
+            }
+
+            Injector<Service> injector;
+            std::uint64_t generation;
+            std::atomic<const binding *> previous;
+        };
+
+        /// @brief Destroy injectors older than the oldest pinned generation
+        static void reclaim(std::uint64_t oldest) noexcept
+        {
+            const binding *node = _history.load(std::memory_order_relaxed);
+            while (node && (node->generation > oldest))
+                node = node->previous.load(std::memory_order_relaxed);
+            if (node)
+                delete const_cast<binding *>(node)->previous.exchange(nullptr);
+        }
+
         /// @brief Injected instance
         service_type _instance = nullptr;
+        /// @brief Injector of the injected instance
+        const Injector<Service> *_binding = &_injector;
+        /// @brief True if this instance pins a generation
+        bool _pinned = false;
         /// @brief Service provider injector
         inline static Injector<Service> _injector;
+        /// @brief Injectors replaced at runtime, newest first
+        inline static std::atomic<const binding *> _history = nullptr;
+        /// @brief True if enrolled for reclamation
+        inline static bool _enrolled = false;
+#ifdef DIP_WIRING_MANIFEST
+        /// @brief Refers to the wiring manifest entry (checked at link time)
+        inline static bool _wired = (wired<Service>(), true);
+#endif
+        /// @brief Sampling period of acquisitions (zero if disabled)
+        inline static std::uint32_t _sampling_period = 0;
+        /// @brief Acquisitions left until the next sample
+        inline static thread_local std::uint32_t _sampling_countdown = 0;
     }; // struct instance
 
     /**
@@ -289,26 +1371,258 @@ namespace dip
     }
 
     /**
-     * @brief Inject a per-thread singleton instance to a Service
+     * @brief Inject a per-thread singleton instance to a Service
+     *
+     * @tparam Service Injectable service
+     * @tparam Provider Service provider
+     * @tparam _Args Constructor argument types
+     * @param args Constructor arguments
+     */
+    template <class Service, class Provider, typename... _Args>
+    inline void inject_thread_singleton(_Args &&...args)
+    {
+        instance<Service>::template inject_thread_singleton<Provider>(
+            std::forward<_Args>(args)...);
+    }
+
+    /**
+     * @brief Inject a singleton instance to a Service
+     *        placed in the singleton arena
+     *
+     * @note To be consumed using dip::instance<Service>
+     *
+     * @tparam Service Injectable service
+     * @tparam Provider Service provider
+     * @tparam _Args Constructor argument types
+     * @param args Constructor arguments
+     */
+    template <class Service, class Provider, typename... _Args>
+    inline void inject_arena_singleton(_Args &&...args)
+    {
+        instance<Service>::template inject_arena_singleton<Provider>(
+            std::forward<_Args>(args)...);
+    }
+
+    /**
+     * @brief Sample the acquisition time of a Service
+     *
+     * @note Results are available at dip::acquisition_histogram<Service>
+     *
+     * @tparam Service Injectable service
+     * @param period Sampling period (one out of @p period per thread),
+     *               or zero to disable sampling
+     */
+    template <class Service>
+    inline void sample_acquisitions(std::uint32_t period)
+    {
+        instance<Service>::sample_acquisitions(period);
+    }
+
+    /**
+     * @brief Replace the injected service provider at runtime
+     *
+     * @note Staged until dip::snapshot::publish() is called
+     *
+     * @tparam Service Injectable service
+     * @param injector Service injector
+     */
+    template <class Service>
+    inline void rebind(const Injector<Service> &injector)
+    {
+        instance<Service>::rebind(injector);
+    }
+
+    /**
+     * @brief Vector having a fixed capacity and no heap allocations
+     *
+     * @tparam T Type of the elements
+     * @tparam N Capacity
+     */
+    template <class T, std::size_t N>
+    struct fixed_vector
+    {
+        /// @brief Forward iterator
+        using iterator = T *;
+        /// @brief Const forward iterator
+        using const_iterator = const T *;
+        /// @brief Reverse iterator
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        /// @brief Const reverse iterator
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /**
+         * @brief Check that the capacity is enough
+         *
+         * @throw std::length_error If @p count exceeds the capacity
+         * @param count Count of elements
+         */
+        void reserve(std::size_t count) const
+        {
+            assert((count <= N) && "Capacity exceeded");
+            if (count > N)
+                throw std::length_error("dip::fixed_vector capacity exceeded");
+        }
+
+        /**
+         * @brief Append an element
+         *
+         * @throw std::length_error If the capacity is exceeded
+         * @param value Element
+         */
+        void push_back(const T &value)
+        {
+            reserve(_size + 1);
+            _items[_size++] = value;
+        }
+
+        /**
+         * @brief Get the count of elements
+         *
+         * @return constexpr std::size_t Count of elements
+         */
+        constexpr std::size_t size() const noexcept { return _size; }
+
+        /**
+         * @brief Get an element (unchecked)
+         *
+         * @param index Index of the element
+         * @return T& Element
+         */
+        T &operator[](std::size_t index) noexcept { return _items[index]; }
+
+        /**
+         * @brief Get an element (unchecked)
+         *
+         * @param index Index of the element
+         * @return const T& Element
+         */
+        const T &operator[](std::size_t index) const noexcept
+        {
+            return _items[index];
+        }
+
+        /**
+         * @brief Get an element
+         *
+         * @throw std::out_of_range If @p index is out of range
+         * @param index Index of the element
+         * @return T& Element
+         */
+        T &at(std::size_t index)
+        {
+            if (index >= _size)
+                throw std::out_of_range("dip::fixed_vector index out of range");
+            return _items[index];
+        }
+
+        /**
+         * @brief Get an element
+         *
+         * @throw std::out_of_range If @p index is out of range
+         * @param index Index of the element
+         * @return const T& Element
+         */
+        const T &at(std::size_t index) const
+        {
+            if (index >= _size)
+                throw std::out_of_range("dip::fixed_vector index out of range");
+            return _items[index];
+        }
+
+        /// @brief returns an iterator to the beginning
+        /// @return Iterator
+        iterator begin() noexcept { return _items.data(); }
+        /// @brief returns an iterator to the beginning
+        /// @return Iterator
+        const_iterator begin() const noexcept { return _items.data(); }
+        /// @brief returns an iterator to the beginning
+        /// @return Iterator
+        const_iterator cbegin() const noexcept { return _items.data(); }
+        /// @brief returns an iterator to the end
+        /// @return Iterator
+        iterator end() noexcept { return _items.data() + _size; }
+        /// @brief returns an iterator to the end
+        /// @return Iterator
+        const_iterator end() const noexcept { return _items.data() + _size; }
+        /// @brief returns an iterator to the end
+        /// @return Iterator
+        const_iterator cend() const noexcept { return _items.data() + _size; }
+        /// @brief returns a reverse iterator to the beginning
+        /// @return Iterator
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        /// @brief returns a reverse iterator to the beginning
+        /// @return Iterator
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        /// @brief returns a reverse iterator to the beginning
+        /// @return Iterator
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+        /// @brief returns a reverse iterator to the end
+        /// @return Iterator
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        /// @brief returns a reverse iterator to the end
+        /// @return Iterator
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+        /// @brief returns a reverse iterator to the end
+        /// @return Iterator
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+    private:
+        std::array<T, N> _items;
+        std::size_t _size = 0;
+    }; // struct fixed_vector
+
+    template <class Service, std::size_t MaxN>
+    struct instance_set;
+
+    /**
+     * @brief Injectors of a set of service providers
+     *
+     * @note Shared by all dip::instance_set<Service, MaxN>
      *
      * @tparam Service Injectable service
-     * @tparam Provider Service provider
-     * @tparam _Args Constructor argument types
-     * @param args Constructor arguments
      */
-    template <class Service, class Provider, typename... _Args>
-    inline void inject_thread_singleton(_Args &&...args)
+    template <class Service>
+    struct injector_set
     {
-        instance<Service>::template inject_thread_singleton<Provider>(
-            std::forward<_Args>(args)...);
-    }
+    private:
+        template <class, std::size_t>
+        friend struct instance_set;
+
+        /// @brief Injector of one or more contiguous service providers
+        struct group
+        {
+            Injector<Service> injector;
+            std::size_t count;
+            std::size_t stride;
+        };
+
+        inline static std::vector<group> _groups;
+        inline static std::size_t _count = 0;
+    }; // struct injector_set
 
     /**
      * @brief Set of injected instances of a service
      *
+     * @note If @p MaxN is not zero, instances are stored in a fixed-capacity
+     *       array within this object (no heap allocations).
+     *       Otherwise, they are stored in a std::vector.
+     *
      * @tparam Service Service to be injected
+     * @tparam MaxN Maximum count of service providers (or zero)
      */
-    template <class Service>
+    template <class Service, std::size_t MaxN = 0>
     struct instance_set
     {
         static_assert(
@@ -322,15 +1636,20 @@ namespace dip
         typedef Service *service_type;
         /// @brief Const type of the instances of the service provider
         typedef const Service *const_service_type;
+        /// @brief Storage of the instances of the service provider
+        using storage_type = std::conditional_t<
+            MaxN == 0,
+            std::vector<service_type>,
+            fixed_vector<service_type, MaxN>>;
         /// @brief Forward iterator
-        using iterator = std::vector<service_type>::iterator;
+        using iterator = typename storage_type::iterator;
         /// @brief Const forward iterator
-        using const_iterator = std::vector<service_type>::const_iterator;
+        using const_iterator = typename storage_type::const_iterator;
         /// @brief Reverse iterator
-        using reverse_iterator = std::vector<service_type>::reverse_iterator;
+        using reverse_iterator = typename storage_type::reverse_iterator;
         /// @brief Const reverse iterator
         using const_reverse_iterator =
-            std::vector<service_type>::const_reverse_iterator;
+            typename storage_type::const_reverse_iterator;
 
         /**
          * @brief Retrieve a set of instances providing the service
@@ -339,12 +1658,18 @@ namespace dip
         instance_set()
         {
             assert(!_injectors.empty() && "No dependency injections");
-            for (auto injector : _injectors)
+            if constexpr (MaxN == 0)
+                realtime_scope::check();
+            _instances.reserve(_count);
+            for (const auto &group : _injectors)
             {
-                assert(injector.acquire && "Missing dependency injection");
-                auto instance = injector.acquire();
+                assert(group.injector.acquire && "Missing dependency injection");
+                auto instance = group.injector.acquire();
                 assert(instance && "An injector retrieved a null provider");
-                _instances.push_back(instance);
+                char *address = reinterpret_cast<char *>(instance);
+                for (std::size_t i = 0; i < group.count; i++)
+                    _instances.push_back(reinterpret_cast<service_type>(
+                        address + i * group.stride));
             }
         }
 
@@ -354,9 +1679,13 @@ namespace dip
          */
         ~instance_set() noexcept
         {
-            for (std::size_t i = 0; i < _injectors.size(); i++)
-                if (_injectors[i].release)
-                    _injectors[i].release(_instances.at(i));
+            std::size_t index = 0;
+            for (const auto &group : _injectors)
+            {
+                if (group.injector.release)
+                    group.injector.release(_instances.at(index));
+                index += group.count;
+            }
         }
 
         instance_set(const instance_set &) = delete;
@@ -464,12 +1793,30 @@ namespace dip
         /**
          * @brief Inject a service provider using a custom injector
          *
+         * @warning Not thread-safe. Must not run concurrently with
+         *          other injections or service consumers.
+         *
          * @param injector Service injector
          */
         static void add(const Injector<Service> &injector) noexcept
         {
             assert(injector.acquire && "Invalid injector");
-            _injectors.push_back(injector);
+            _injectors.push_back({injector, 1, 0});
+            _count++;
+        }
+
+        /**
+         * @brief Inject a service provider using a custom injector
+         *
+         * @note Avoids copying the injector functions
+         *
+         * @param injector Service injector
+         */
+        static void add(Injector<Service> &&injector) noexcept
+        {
+            assert(injector.acquire && "Invalid injector");
+            _injectors.push_back({std::move(injector), 1, 0});
+            _count++;
         }
 
         /**
@@ -489,10 +1836,16 @@ namespace dip
                 .acquire =
                     [... args = std::forward<_Args>(__args)]() -> Service *
                 {
+                    [[maybe_unused]] static bool constructing = realtime_scope::check();
                     static Provider p(args...);
+                    if constexpr (checkpointable<Provider>)
+                    {
+                        [[maybe_unused]] static bool restored =
+                            checkpoint::attach<Service>(p, "set_singleton");
+                    }
                     return &p;
                 }};
-            add(injector);
+            add(std::move(injector));
         }
 
         /**
@@ -512,10 +1865,43 @@ namespace dip
                 .acquire =
                     [... args = std::forward<_Args>(__args)]() -> Service *
                 {
+                    [[maybe_unused]] static thread_local bool constructing =
+                        realtime_scope::check();
                     static thread_local Provider p(args...);
                     return &p;
                 }};
-            add(injector);
+            add(std::move(injector));
+        }
+
+        /**
+         * @brief Inject a service provider with singleton life cycle
+         *        placed in the singleton arena
+         *
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor parameter types
+         * @param __args Constructor parameters
+         */
+        template <class Provider, typename... _Args>
+        static void add_arena_singleton(_Args &&...__args)
+        {
+            static_assert(
+                std::is_base_of<Service, Provider>::value,
+                "Provider does not implement Service");
+            Injector<Service> injector{
+                .acquire =
+                    [... args = std::forward<_Args>(__args)]() -> Service *
+                {
+                    [[maybe_unused]] static bool constructing =
+                        realtime_scope::check();
+                    static singleton_arena::slot<Provider> p(args...);
+                    if constexpr (checkpointable<Provider>)
+                    {
+                        [[maybe_unused]] static bool restored =
+                            checkpoint::attach<Service>(*p.get(), "set_arena_singleton");
+                    }
+                    return p.get();
+                }};
+            add(std::move(injector));
         }
 
         /**
@@ -528,6 +1914,9 @@ namespace dip
         template <class Provider, typename... _Args>
         static void add_transient(_Args &&...__args)
         {
+            static_assert(
+                !hot<Service>::value,
+                "A hot service cannot have a transient life cycle");
             static_assert(
                 std::is_base_of<Service, Provider>::value,
                 "Provider does not implement Service");
@@ -535,14 +1924,71 @@ namespace dip
                 .acquire =
                     [... args = std::forward<_Args>(__args)]() -> Service *
                 {
-                    static thread_local Provider p(args...);
-                    return &p;
+                    realtime_scope::check();
+                    return new Provider(args...);
                 },
                 .release = [](Service *provider) -> void
                 {
+                    realtime_scope::check();
                     delete provider;
                 }};
-            add(injector);
+            add(std::move(injector));
+        }
+
+        /**
+         * @brief Inject many service providers of the same type
+         *        with transient life cycle
+         *
+         * @note All the service providers are allocated
+         *       in a single contiguous block, so iteration
+         *       streams through memory.
+         *
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor parameter types
+         * @param count Count of service providers (non-zero)
+         * @param __args Constructor parameters (shared by all of them)
+         */
+        template <class Provider, typename... _Args>
+        static void add_transient_array(std::size_t count, _Args &&...__args)
+        {
+            static_assert(
+                !hot<Service>::value,
+                "A hot service cannot have a transient life cycle");
+            static_assert(
+                std::is_base_of<Service, Provider>::value,
+                "Provider does not implement Service");
+            assert((count > 0) && "Invalid count of service providers");
+            Injector<Service> injector{
+                .acquire =
+                    [count, ... args = std::forward<_Args>(__args)]() -> Service *
+                {
+                    realtime_scope::check();
+                    std::allocator<Provider> allocator;
+                    Provider *block = allocator.allocate(count);
+                    std::size_t i = 0;
+                    try
+                    {
+                        for (; i < count; i++)
+                            std::construct_at(block + i, args...);
+                    }
+                    catch (...)
+                    {
+                        std::destroy_n(block, i);
+                        allocator.deallocate(block, count);
+                        throw;
+                    }
+                    return block;
+                },
+                .release = [count](Service *provider) -> void
+                {
+                    realtime_scope::check();
+                    Provider *block = static_cast<Provider *>(provider);
+                    std::destroy_n(block, count);
+                    std::allocator<Provider>().deallocate(block, count);
+                }};
+            assert(injector.acquire && "Invalid injector");
+            _injectors.push_back({std::move(injector), count, sizeof(Provider)});
+            _count += count;
         }
 
         /**
@@ -556,11 +2002,13 @@ namespace dip
         static void clear_injections() noexcept
         {
             _injectors.clear();
+            _count = 0;
         }
 
     private:
-        std::vector<service_type> _instances;
-        inline static std::vector<Injector<Service>> _injectors;
+        storage_type _instances;
+        static constexpr auto &_injectors = injector_set<Service>::_groups;
+        static constexpr auto &_count = injector_set<Service>::_count;
     }; // struct instances
 
     /**
@@ -627,4 +2075,417 @@ namespace dip
         instance_set<Service>::template add_thread_singleton<Provider>(
             std::forward<_Args>(args)...);
     }
+
+    /**
+     * @brief Inject a singleton instance to a Service
+     *        placed in the singleton arena
+     *
+     * @note To be consumed using dip::instance_set<Service>
+     *
+     * @tparam Service Injectable service
+     * @tparam Provider Service provider
+     * @tparam _Args Constructor argument types
+     * @param args Constructor arguments
+     */
+    template <class Service, class Provider, typename... _Args>
+    inline void add_arena_singleton(_Args &&...args)
+    {
+        instance_set<Service>::template add_arena_singleton<Provider>(
+            std::forward<_Args>(args)...);
+    }
+
+    /**
+     * @brief Inject many transient instances of the same type to a Service
+     *
+     * @note To be consumed using dip::instance_set<Service>
+     *
+     * @tparam Service Injectable service
+     * @tparam Provider Service provider
+     * @tparam _Args Constructor argument types
+     * @param count Count of service providers
+     * @param args Constructor arguments
+     */
+    template <class Service, class Provider, typename... _Args>
+    inline void add_transient_array(std::size_t count, _Args &&...args)
+    {
+        instance_set<Service>::template add_transient_array<Provider>(
+            count, std::forward<_Args>(args)...);
+    }
+
+    /**
+     * @brief Prefetch memory into the cache
+     *
+     * @param address Memory address
+     */
+    inline void prefetch(const void *address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    /**
+     * @brief Call a function for every service provider in a set,
+     *        prefetching service providers ahead
+     *
+     * @note Service provider instances are prefetched @p distance
+     *       positions ahead, so virtual calls do not stall on cache misses.
+     *       Virtual tables are not prefetched: reading the vtable pointer
+     *       would load the provider itself and stall if the prefetch
+     *       has not landed yet. There are few of them, so they are
+     *       usually cached anyway.
+     *       Useful for large sets of service providers scattered in the heap.
+     *
+     * @tparam Set Set of service providers (for example, dip::instance_set)
+     * @tparam Function Callable taking a service provider instance
+     * @param set Set of service providers
+     * @param fn Function to call
+     * @param distance Prefetch distance
+     */
+    template <class Set, class Function>
+    inline void for_each_prefetched(Set &set, Function fn, std::size_t distance = 8)
+    {
+        const std::size_t size = set.size();
+        for (std::size_t i = 0; i < size; i++)
+        {
+            if (i + distance < size)
+                prefetch(set[i + distance]);
+            fn(set[i]);
+        }
+    }
+
+    /**
+     * @brief Profile selection trait
+     *
+     * @note Specialize as std::true_type to select a wiring profile
+     *       at compile time.
+     *
+     * @tparam Tag Any type identifying the profile
+     */
+    template <class Tag>
+    struct profile_selected : std::false_type
+    {
+    };
+
+    /**
+     * @brief Wiring profile selected at compile time
+     *
+     * @note Dependency injections in unselected profiles are discarded
+     *       at compile time: their service providers are never
+     *       instantiated nor linked, and there are no runtime branches.
+     *
+     * @tparam Tag Any type identifying the profile
+     */
+    template <class Tag>
+    struct profile
+    {
+        /// @brief True if the profile is selected
+        static constexpr bool selected = profile_selected<Tag>::value;
+
+        /**
+         * @brief Forward to dip::inject() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @param injector Service injector
+         */
+        template <class Service>
+        static void inject(const Injector<Service> &injector)
+        {
+            if constexpr (selected)
+                dip::inject<Service>(injector);
+        }
+
+        /**
+         * @brief Forward to dip::inject_singleton() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void inject_singleton(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::inject_singleton<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::inject_thread_singleton() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void inject_thread_singleton(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::inject_thread_singleton<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::inject_arena_singleton() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void inject_arena_singleton(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::inject_arena_singleton<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::inject_transient() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void inject_transient(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::inject_transient<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::add() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @param injector Service injector
+         */
+        template <class Service>
+        static void add(const Injector<Service> &injector)
+        {
+            if constexpr (selected)
+                dip::add<Service>(injector);
+        }
+
+        /**
+         * @brief Forward to dip::add_singleton() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void add_singleton(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::add_singleton<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::add_thread_singleton() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void add_thread_singleton(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::add_thread_singleton<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::add_arena_singleton() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void add_arena_singleton(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::add_arena_singleton<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::add_transient() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void add_transient(_Args &&...args)
+        {
+            if constexpr (selected)
+                dip::add_transient<Service, Provider>(
+                    std::forward<_Args>(args)...);
+        }
+
+        /**
+         * @brief Forward to dip::add_transient_array() if the profile is selected
+         *
+         * @tparam Service Injectable service
+         * @tparam Provider Service provider
+         * @tparam _Args Constructor argument types
+         * @param count Count of service providers
+         * @param args Constructor arguments
+         */
+        template <class Service, class Provider, typename... _Args>
+        static void add_transient_array(std::size_t count, _Args &&...args)
+        {
+            if constexpr (selected)
+                dip::add_transient_array<Service, Provider>(
+                    count, std::forward<_Args>(args)...);
+        }
+    }; // struct profile
+
+    /**
+     * @brief Dependency injection registered at static-initialization time
+     *
+     * @note Use the DIP_REGISTER() and DIP_REGISTER_SET() macros.
+     *       No std::function is constructed at static-initialization time.
+     *       Registered injections take place when wire_registered()
+     *       is called, in ascending order of priority.
+     */
+    struct registration
+    {
+        /// @brief Type of a function performing a dependency injection
+        typedef void (*WiringFunction)();
+
+        /**
+         * @brief Register a dependency injection
+         *
+         * @param priority Lower values are injected first.
+         *                 Equal values keep declaration order.
+         * @param wire Function performing the dependency injection
+         */
+        registration(int priority, WiringFunction wire) noexcept
+            : _priority{priority}, _wire{wire}, _next{_head}
+        {
+            _head = this;
+        }
+
+        registration(const registration &) = delete;
+        registration(registration &&) = delete;
+        registration &operator=(const registration &) = delete;
+        registration &operator=(registration &&) = delete;
+
+        /**
+         * @brief Perform all registered dependency injections
+         *
+         * @warning Call once at program startup.
+         */
+        static void wire_all()
+        {
+            // Stable insertion sort by priority. No allocations.
+            // Registrations are listed in reverse declaration order,
+            // so ties are inserted before each other.
+            registration *sorted = nullptr;
+            while (_head)
+            {
+                registration *node = _head;
+                _head = node->_next;
+                registration **slot = &sorted;
+                while (*slot && ((*slot)->_priority < node->_priority))
+                    slot = &(*slot)->_next;
+                node->_next = *slot;
+                *slot = node;
+            }
+            _head = sorted;
+            for (registration *node = _head; node; node = node->_next)
+                node->_wire();
+        }
+
+    private:
+        int _priority;
+        WiringFunction _wire;
+        registration *_next;
+        inline static registration *_head = nullptr;
+    }; // struct registration
+
+    /**
+     * @brief Perform all dependency injections registered
+     *        by DIP_REGISTER() and DIP_REGISTER_SET()
+     *
+     * @warning Call once at program startup.
+     */
+    inline void wire_registered()
+    {
+        registration::wire_all();
+    }
 }; // namespace dip
+
+#define DIP_CONCAT_IMPL(a, b) a##b
+#define DIP_CONCAT(a, b) DIP_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Declare the binding of a service in the wiring manifest
+ *
+ * @note Use once per service, at global scope, in the wiring code.
+ *       Not needed for services registered with DIP_REGISTER().
+ *       Expands to nothing unless DIP_WIRING_MANIFEST is defined.
+ *
+ * @param Service Injectable service
+ */
+#ifdef DIP_WIRING_MANIFEST
+#define DIP_WIRED(Service) \
+    template <>            \
+    void dip::wired<Service>() {}
+#else
+#define DIP_WIRED(Service)
+#endif
+
+/**
+ * @brief Register a dependency injection to be consumed
+ *        using dip::instance<Service>
+ *
+ * @param Service Injectable service
+ * @param Provider Service provider
+ * @param lifecycle One of: singleton, thread_singleton, arena_singleton,
+ *                  transient
+ * @param priority Lower values are injected first
+ * @param ... Constructor arguments (optional)
+ *
+ * @note Also declares the binding in the wiring manifest (DIP_WIRED()),
+ *       so use at global scope.
+ */
+#define DIP_REGISTER(Service, Provider, lifecycle, priority, ...)            \
+    DIP_WIRED(Service)                                                       \
+    static ::dip::registration DIP_CONCAT(_dip_registration_, __COUNTER__)( \
+        priority,                                                            \
+        []() { ::dip::inject_##lifecycle<Service, Provider>(__VA_ARGS__); })
+
+/**
+ * @brief Register a dependency injection to be consumed
+ *        using dip::instance_set<Service>
+ *
+ * @param Service Injectable service
+ * @param Provider Service provider
+ * @param lifecycle One of: singleton, thread_singleton, arena_singleton,
+ *                  transient
+ * @param priority Lower values are injected first
+ * @param ... Constructor arguments (optional)
+ */
+#define DIP_REGISTER_SET(Service, Provider, lifecycle, priority, ...)        \
+    static ::dip::registration DIP_CONCAT(_dip_registration_, __COUNTER__)( \
+        priority,                                                            \
+        []() { ::dip::add_##lifecycle<Service, Provider>(__VA_ARGS__); })
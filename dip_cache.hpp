@@ -0,0 +1,273 @@
+/**
+ * @file dip_cache.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain.
+ * @brief Caching decorators: memoization and call coalescing
+ * @date 2025-11-09
+ *
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+#pragma once
+
+#include "dip.hpp"
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <list>
+
+namespace dip
+{
+    /**
+     * @brief Concurrent memoization cache
+     *
+     * @note Intended for caching decorators: service providers wrapping
+     *       another service provider and memoizing pure lookup methods.
+     *       Entries are distributed into independently locked shards.
+     *       Every shard evicts its least recently used entries.
+     *
+     * @tparam Key Type of the arguments (hashable and equality comparable)
+     * @tparam Value Type of the results (copy-constructible)
+     * @tparam Hash Hash function of the arguments
+     */
+    template <class Key, class Value, class Hash = std::hash<Key>>
+    class memo_cache
+    {
+    public:
+        /// @brief Clock used for expiration
+        typedef std::chrono::steady_clock clock;
+
+        /**
+         * @brief Create a cache
+         *
+         * @param capacity Maximum count of entries
+         * @param ttl Time to live of every entry
+         * @param shards Count of shards
+         */
+        memo_cache(
+            std::size_t capacity,
+            clock::duration ttl,
+            std::size_t shards = 16)
+            : _shards(std::max<std::size_t>(shards, 1)),
+              _shard_capacity{std::max<std::size_t>(capacity / _shards.size(), 1)},
+              _ttl{ttl}
+        {
+        }
+
+        memo_cache(const memo_cache &) = delete;
+        memo_cache(memo_cache &&) = delete;
+        memo_cache &operator=(const memo_cache &) = delete;
+        memo_cache &operator=(memo_cache &&) = delete;
+
+        /**
+         * @brief Get a cached result or compute it
+         *
+         * @note @p compute is called without holding any lock
+         *
+         * @tparam Function Callable taking no arguments and returning Value
+         * @param key Arguments
+         * @param compute Function computing the result
+         * @return Value Result
+         */
+        template <class Function>
+        Value get(const Key &key, Function compute)
+        {
+            std::size_t hash = Hash{}(key);
+            shard &target = _shards[hash % _shards.size()];
+            {
+                std::lock_guard lock(target.mutex);
+                auto found = target.entries.find(key);
+                if (found != target.entries.end())
+                {
+                    if (found->second.expires > clock::now())
+                    {
+                        target.recent.splice(
+                            target.recent.begin(),
+                            target.recent,
+                            found->second.position);
+                        _hits.fetch_add(1, std::memory_order_relaxed);
+                        return found->second.value;
+                    }
+                    target.recent.erase(found->second.position);
+                    target.entries.erase(found);
+                }
+            }
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            Value value = compute();
+            put(target, key, value);
+            return value;
+        }
+
+        /**
+         * @brief Remove all entries
+         *
+         */
+        void clear()
+        {
+            for (auto &target : _shards)
+            {
+                std::lock_guard lock(target.mutex);
+                target.entries.clear();
+                target.recent.clear();
+            }
+        }
+
+        /**
+         * @brief Get the count of cache hits
+         *
+         * @return std::uint64_t Count of hits
+         */
+        std::uint64_t hits() const noexcept
+        {
+            return _hits.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the count of cache misses
+         *
+         * @return std::uint64_t Count of misses
+         */
+        std::uint64_t misses() const noexcept
+        {
+            return _misses.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the hit rate
+         *
+         * @return double Hits divided by lookups (zero if none)
+         */
+        double hit_rate() const noexcept
+        {
+            double lookups = static_cast<double>(hits() + misses());
+            return (lookups > 0) ? hits() / lookups : 0.0;
+        }
+
+    private:
+        struct entry
+        {
+            Value value;
+            clock::time_point expires;
+            typename std::list<Key>::iterator position;
+        };
+
+        struct shard
+        {
+            std::mutex mutex;
+            std::unordered_map<Key, entry, Hash> entries;
+            std::list<Key> recent;
+        };
+
+        void put(shard &target, const Key &key, const Value &value)
+        {
+            std::lock_guard lock(target.mutex);
+            auto expires = clock::now() + _ttl;
+            auto found = target.entries.find(key);
+            if (found != target.entries.end())
+            {
+                found->second.value = value;
+                found->second.expires = expires;
+                return;
+            }
+            if (target.entries.size() >= _shard_capacity)
+            {
+                target.entries.erase(target.recent.back());
+                target.recent.pop_back();
+            }
+            target.recent.push_front(key);
+            target.entries.emplace(key, entry{value, expires, target.recent.begin()});
+        }
+
+        std::vector<shard> _shards;
+        std::size_t _shard_capacity;
+        clock::duration _ttl;
+        std::atomic<std::uint64_t> _hits = 0;
+        std::atomic<std::uint64_t> _misses = 0;
+    }; // class memo_cache
+
+    /**
+     * @brief Coalescing of concurrent identical calls
+     *
+     * @note Intended for decorators: service providers wrapping
+     *       another service provider.
+     *       While a call is running, concurrent calls having equal
+     *       arguments do not run. Instead, they wait for the running
+     *       call and get its result (or exception).
+     *
+     * @tparam Key Type of the arguments (hashable and equality comparable)
+     * @tparam Value Type of the results (copy-constructible)
+     * @tparam Hash Hash function of the arguments
+     */
+    template <class Key, class Value, class Hash = std::hash<Key>>
+    class single_flight
+    {
+    public:
+        single_flight() = default;
+        single_flight(const single_flight &) = delete;
+        single_flight(single_flight &&) = delete;
+        single_flight &operator=(const single_flight &) = delete;
+        single_flight &operator=(single_flight &&) = delete;
+
+        /**
+         * @brief Run a call, unless an identical one is already running
+         *
+         * @tparam Function Callable taking no arguments and returning Value
+         * @param key Arguments
+         * @param fn Function performing the call
+         * @return Value Result
+         */
+        template <class Function>
+        Value call(const Key &key, Function fn)
+        {
+            std::unique_lock lock(_mutex);
+            auto found = _calls.find(key);
+            if (found != _calls.end())
+            {
+                std::shared_future<Value> running = found->second;
+                lock.unlock();
+                _coalesced.fetch_add(1, std::memory_order_relaxed);
+                return running.get();
+            }
+            std::promise<Value> promise;
+            _calls.emplace(key, promise.get_future().share());
+            lock.unlock();
+            try
+            {
+                Value value = fn();
+                promise.set_value(value);
+                forget(key);
+                return value;
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+                forget(key);
+                throw;
+            }
+        }
+
+        /**
+         * @brief Get the count of calls that did not run
+         *
+         * @return std::uint64_t Count of coalesced calls
+         */
+        std::uint64_t coalesced() const noexcept
+        {
+            return _coalesced.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void forget(const Key &key)
+        {
+            std::lock_guard lock(_mutex);
+            _calls.erase(key);
+        }
+
+        std::mutex _mutex;
+        std::unordered_map<Key, std::shared_future<Value>, Hash> _calls;
+        std::atomic<std::uint64_t> _coalesced = 0;
+    }; // class single_flight
+}; // namespace dip
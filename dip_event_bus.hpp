@@ -0,0 +1,301 @@
+/**
+ * @file dip_event_bus.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain.
+ * @brief Asynchronous event delivery to service provider sets
+ * @date 2025-11-09
+ *
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+#pragma once
+
+#include "dip.hpp"
+#include <algorithm>
+#include <stop_token>
+#include <thread>
+
+namespace dip
+{
+    /**
+     * @brief Subscriber service to events of a given type
+     *
+     * @note Inject service providers using dip::add*() methods
+     *       to subscribe to a dip::event_bus<Event>.
+     *
+     * @tparam Event Type of the events
+     */
+    template <class Event>
+    class Subscriber
+    {
+    public:
+        /**
+         * @brief Handle a batch of events
+         *
+         * @note Called from a dispatcher thread, never concurrently.
+         *
+         * @param events Array of events, in order of publication
+         * @param count Count of events (non-zero)
+         */
+        virtual void on_events(const Event *events, std::size_t count) = 0;
+
+        virtual ~Subscriber() {};
+    }; // class Subscriber
+
+    /**
+     * @brief Bounded lock-free multiple-producer single-consumer queue
+     *
+     * @tparam Event Type of the events
+     *               (default-constructible and copy-assignable)
+     */
+    template <class Event>
+    class mailbox
+    {
+    public:
+        /**
+         * @brief Create a mailbox
+         *
+         * @param capacity Capacity (rounded up to a power of two)
+         */
+        mailbox(std::size_t capacity)
+            : _cells(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+              _mask{_cells.size() - 1}
+        {
+            for (std::size_t i = 0; i < _cells.size(); i++)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        mailbox(const mailbox &) = delete;
+        mailbox(mailbox &&) = delete;
+        mailbox &operator=(const mailbox &) = delete;
+        mailbox &operator=(mailbox &&) = delete;
+
+        /**
+         * @brief Enqueue an event (any thread)
+         *
+         * @param event Event
+         * @return true On success
+         * @return false If full
+         */
+        bool push(const Event &event)
+        {
+            cell *target;
+            std::size_t position = _enqueue.load(std::memory_order_relaxed);
+            while (true)
+            {
+                target = &_cells[position & _mask];
+                std::size_t sequence =
+                    target->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+                if (diff == 0)
+                {
+                    if (_enqueue.compare_exchange_weak(
+                            position,
+                            position + 1,
+                            std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    position = _enqueue.load(std::memory_order_relaxed);
+            }
+            target->value = event;
+            target->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Dequeue events (consumer thread only)
+         *
+         * @param out Buffer for the events
+         * @param max Maximum count of events to dequeue
+         * @return std::size_t Count of dequeued events
+         */
+        std::size_t pop(Event *out, std::size_t max)
+        {
+            std::size_t count = 0;
+            while (count < max)
+            {
+                cell &source = _cells[_dequeue & _mask];
+                if (source.sequence.load(std::memory_order_acquire) !=
+                    _dequeue + 1)
+                    break;
+                out[count++] = std::move(source.value);
+                source.sequence.store(
+                    _dequeue + _mask + 1,
+                    std::memory_order_release);
+                _dequeue++;
+            }
+            return count;
+        }
+
+    private:
+        struct cell
+        {
+            std::atomic<std::size_t> sequence;
+            Event value;
+        };
+
+        std::vector<cell> _cells;
+        std::size_t _mask;
+        alignas(64) std::atomic<std::size_t> _enqueue = 0;
+        alignas(64) std::size_t _dequeue = 0;
+    }; // class mailbox
+
+    /**
+     * @brief Policy when a subscriber's mailbox is full
+     *
+     */
+    enum class backpressure
+    {
+        /// @brief The publisher waits
+        block,
+        /// @brief The event is dropped for that subscriber
+        drop
+    };
+
+    /**
+     * @brief Asynchronous publish/subscribe event bus
+     *
+     * @note Subscribers are the service providers injected into
+     *       dip::Subscriber<Event> using dip::add*() methods.
+     *       Every subscriber has its own lock-free mailbox and
+     *       dispatcher thread, which delivers events in batches,
+     *       so slow subscribers do not throttle publishers.
+     *
+     * @tparam Event Type of the events
+     *               (default-constructible and copy-assignable)
+     */
+    template <class Event>
+    class event_bus
+    {
+    public:
+        /**
+         * @brief Create an event bus and start dispatching
+         *
+         * @param capacity Capacity of each mailbox
+         * @param batch Maximum count of events delivered at once
+         * @param policy Policy when a mailbox is full
+         */
+        event_bus(
+            std::size_t capacity = 1024,
+            std::size_t batch = 64,
+            backpressure policy = backpressure::block)
+            : _policy{policy}
+        {
+            assert((batch > 0) && "Invalid batch size");
+            _channels.reserve(_subscribers.size());
+            for (auto subscriber : _subscribers)
+                _channels.push_back(
+                    std::make_unique<channel>(subscriber, capacity, batch));
+        }
+
+        /**
+         * @brief Deliver all pending events and stop dispatching
+         *
+         */
+        ~event_bus() noexcept
+        {
+            for (auto &c : _channels)
+                c->dispatcher.request_stop();
+            for (auto &c : _channels)
+                c->wake();
+        }
+
+        event_bus(const event_bus &) = delete;
+        event_bus(event_bus &&) = delete;
+        event_bus &operator=(const event_bus &) = delete;
+        event_bus &operator=(event_bus &&) = delete;
+
+        /**
+         * @brief Publish an event to all subscribers
+         *
+         * @param event Event
+         * @return true If all subscribers got the event
+         * @return false If any subscriber dropped the event
+         *               (dip::backpressure::drop policy)
+         */
+        bool publish(const Event &event)
+        {
+            bool delivered = true;
+            for (auto &c : _channels)
+            {
+                while (!c->box.push(event))
+                {
+                    if (_policy == backpressure::drop)
+                    {
+                        _dropped.fetch_add(1, std::memory_order_relaxed);
+                        delivered = false;
+                        break;
+                    }
+                    c->wake();
+                    std::this_thread::yield();
+                }
+                c->wake();
+            }
+            return delivered;
+        }
+
+        /**
+         * @brief Get the count of dropped events
+         *
+         * @return std::uint64_t Count of events dropped by any subscriber
+         */
+        std::uint64_t dropped() const noexcept
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct channel
+        {
+            channel(
+                Subscriber<Event> *subscriber,
+                std::size_t capacity,
+                std::size_t batch)
+                : box{capacity},
+                  dispatcher{[this, subscriber, batch](std::stop_token stop)
+                             { dispatch(subscriber, batch, stop); }}
+            {
+            }
+
+            void wake() noexcept
+            {
+                signal.fetch_add(1, std::memory_order_release);
+                signal.notify_one();
+            }
+
+            void dispatch(
+                Subscriber<Event> *subscriber,
+                std::size_t batch,
+                std::stop_token stop)
+            {
+                std::vector<Event> buffer(batch);
+                while (true)
+                {
+                    auto seen = signal.load(std::memory_order_acquire);
+                    std::size_t count = box.pop(buffer.data(), batch);
+                    if (count > 0)
+                        subscriber->on_events(buffer.data(), count);
+                    else if (stop.stop_requested())
+                        return;
+                    else
+                        signal.wait(seen, std::memory_order_acquire);
+                }
+            }
+
+            mailbox<Event> box;
+            std::atomic<std::uint32_t> signal = 0;
+            std::jthread dispatcher;
+        };
+
+        instance_set<Subscriber<Event>> _subscribers;
+        std::vector<std::unique_ptr<channel>> _channels;
+        backpressure _policy;
+        std::atomic<std::uint64_t> _dropped = 0;
+    }; // class event_bus
+}; // namespace dip
@@ -0,0 +1,465 @@
+/**
+ * @file dip_parallel.hpp
+ *
+ * @author Ángel Fernández Pineda. Madrid. Spain.
+ * @brief Executors and parallel algorithms over service provider sets
+ * @date 2025-11-09
+ *
+ * @copyright Minimal Dependency Injection Framework for C++
+ *            © 2025 by Ángel Fernández Pineda. Madrid. Spain. 2025.
+ *            is licensed under Creative Commons Attribution 4.0 International
+ *
+ */
+
+#pragma once
+
+#include "dip.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <latch>
+#include <optional>
+#include <stop_token>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace dip
+{
+    /**
+     * @brief Executor service
+     *
+     * @note Inject a service provider to run parallel algorithms
+     *       such as dip::gather(), dip::any_of() or dip::all_of().
+     */
+    class Executor
+    {
+    public:
+        /// @brief Type of a task
+        typedef std::function<void()> Task;
+
+        /**
+         * @brief Run a task, now or later, in any thread
+         *
+         * @param task Task to run
+         */
+        virtual void submit(Task task) = 0;
+
+        virtual ~Executor() {};
+    }; // class Executor
+
+    /**
+     * @brief Executor running tasks in the calling thread
+     *
+     */
+    class inline_executor : public Executor
+    {
+    public:
+        virtual void submit(Task task) override { task(); }
+    }; // class inline_executor
+
+    /**
+     * @brief Work-stealing thread pool
+     *
+     * @note Every worker thread has its own task queue.
+     *       Tasks submitted from a worker thread go to its own queue
+     *       (last in, first out). Other tasks are distributed
+     *       in round robin. Idle workers steal tasks from other queues
+     *       (first in, first out).
+     *       Inject as a singleton, so all service providers share
+     *       the same pool:
+     *       `dip::inject_singleton<dip::Executor, dip::work_stealing_executor>()`
+     *
+     * @warning Tasks must not throw nor wait for other tasks.
+     */
+    class work_stealing_executor : public Executor
+    {
+    public:
+        /**
+         * @brief Start the worker threads
+         *
+         * @param size Count of worker threads (zero means one per CPU)
+         * @param pin True to pin every worker thread to a CPU (Linux only)
+         */
+        work_stealing_executor(std::size_t size = 0, bool pin = false)
+        {
+            const std::size_t cpu_count =
+                std::max(1u, std::thread::hardware_concurrency());
+            if (size == 0)
+                size = cpu_count;
+            _workers.reserve(size);
+            for (std::size_t i = 0; i < size; i++)
+                _workers.push_back(std::make_unique<worker>());
+            for (std::size_t i = 0; i < size; i++)
+            {
+                _workers[i]->thread =
+                    std::thread(&work_stealing_executor::run, this, i);
+#if defined(__linux__)
+                if (pin)
+                {
+                    cpu_set_t cpus;
+                    CPU_ZERO(&cpus);
+                    CPU_SET(i % cpu_count, &cpus);
+                    pthread_setaffinity_np(
+                        _workers[i]->thread.native_handle(),
+                        sizeof(cpus),
+                        &cpus);
+                }
+#else
+                (void)pin;
+#endif
+            }
+        }
+
+        /**
+         * @brief Run all pending tasks and stop the worker threads
+         *
+         */
+        virtual ~work_stealing_executor() noexcept
+        {
+            {
+                std::lock_guard lock(_idle_mutex);
+                _stopping = true;
+            }
+            _idle.notify_all();
+            for (auto &w : _workers)
+                w->thread.join();
+        }
+
+        work_stealing_executor(const work_stealing_executor &) = delete;
+        work_stealing_executor(work_stealing_executor &&) = delete;
+        work_stealing_executor &operator=(const work_stealing_executor &) = delete;
+        work_stealing_executor &operator=(work_stealing_executor &&) = delete;
+
+        virtual void submit(Task task) override
+        {
+            std::size_t index = (_current == this)
+                                    ? _current_index
+                                    : _next.fetch_add(1, std::memory_order_relaxed) %
+                                          _workers.size();
+            // Count the task before publishing it,
+            // so a worker popping it never decrements below zero
+            {
+                std::lock_guard lock(_idle_mutex);
+                _pending++;
+            }
+            {
+                std::lock_guard lock(_workers[index]->mutex);
+                _workers[index]->tasks.push_back(std::move(task));
+            }
+            _idle.notify_one();
+        }
+
+        /**
+         * @brief Get the count of worker threads
+         *
+         * @return std::size_t Count of worker threads
+         */
+        std::size_t size() const noexcept { return _workers.size(); }
+
+    private:
+        struct worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+            std::thread thread;
+        };
+
+        bool try_pop(std::size_t index, Task &task)
+        {
+            {
+                worker &own = *_workers[index];
+                std::lock_guard lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t i = 1; i < _workers.size(); i++)
+            {
+                worker &victim = *_workers[(index + i) % _workers.size()];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void run(std::size_t index)
+        {
+            _current = this;
+            _current_index = index;
+            Task task;
+            while (true)
+            {
+                if (try_pop(index, task))
+                {
+                    _pending.fetch_sub(1, std::memory_order_relaxed);
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock lock(_idle_mutex);
+                _idle.wait(lock, [this]()
+                           { return (_pending > 0) || _stopping; });
+                if (_stopping && (_pending == 0))
+                    return;
+            }
+        }
+
+        std::vector<std::unique_ptr<worker>> _workers;
+        std::atomic<std::size_t> _next = 0;
+        std::atomic<std::size_t> _pending = 0;
+        std::mutex _idle_mutex;
+        std::condition_variable _idle;
+        bool _stopping = false;
+        inline static thread_local work_stealing_executor *_current = nullptr;
+        inline static thread_local std::size_t _current_index = 0;
+    }; // class work_stealing_executor
+
+    /**
+     * @brief Call a function for every index in a range, in parallel,
+     *        using the injected dip::Executor
+     *
+     * @note Returns when all calls are complete.
+     *       If any call throws, the first exception is rethrown.
+     *       No heap allocations are required per call.
+     *
+     * @tparam Function Callable taking an index
+     * @param count Count of indexes, starting at zero
+     * @param body Function to call
+     */
+    template <class Function>
+    inline void parallel_for(std::size_t count, Function body)
+    {
+        struct context
+        {
+            context(Function &body, std::size_t count)
+                : body{body}, done{static_cast<std::ptrdiff_t>(count)} {}
+
+            void run(std::size_t index) noexcept
+            {
+                try
+                {
+                    body(index);
+                }
+                catch (...)
+                {
+                    if (!failed.test_and_set())
+                        error = std::current_exception();
+                }
+                done.count_down();
+            }
+
+            Function &body;
+            std::latch done;
+            std::exception_ptr error;
+            std::atomic_flag failed;
+        };
+
+        if (count == 0)
+            return;
+        instance<Executor> executor;
+        context ctx(body, count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            try
+            {
+                // Small enough to avoid allocations in std::function
+                executor->submit([c = &ctx, i]()
+                                 { c->run(i); });
+            }
+            catch (...)
+            {
+                ctx.done.count_down(count - i);
+                ctx.done.wait();
+                throw;
+            }
+        }
+        ctx.done.wait();
+        if (ctx.error)
+            std::rethrow_exception(ctx.error);
+    }
+
+    /**
+     * @brief Call a function for every service provider in a set,
+     *        in parallel, and gather the results
+     *
+     * @note `out[i]` is assigned the result of `fn(set[i])`,
+     *       so the order of results is deterministic.
+     *
+     * @tparam Set Set of service providers (for example, dip::instance_set)
+     * @tparam Function Callable taking a service provider instance
+     * @tparam RandomIt Random access iterator or pointer
+     * @param set Set of service providers
+     * @param fn Function to call
+     * @param out Preallocated buffer having room for `set.size()` results
+     */
+    template <class Set, class Function, class RandomIt>
+    inline void gather(Set &set, Function fn, RandomIt out)
+    {
+        parallel_for(
+            set.size(),
+            [&set, &fn, &out](std::size_t i)
+            { out[i] = fn(set[i]); });
+    }
+
+    /**
+     * @brief Check, in parallel, if a predicate holds
+     *        for any service provider in a set
+     *
+     * @note Once the predicate holds, remaining calls are cancelled.
+     *
+     * @tparam Set Set of service providers (for example, dip::instance_set)
+     * @tparam Predicate Callable taking a service provider instance
+     * @param set Set of service providers
+     * @param pred Predicate
+     * @return true If @p pred holds for any service provider
+     * @return false Otherwise
+     */
+    template <class Set, class Predicate>
+    inline bool any_of(Set &set, Predicate pred)
+    {
+        std::atomic<bool> found = false;
+        parallel_for(
+            set.size(),
+            [&set, &pred, &found](std::size_t i)
+            {
+                if (!found.load(std::memory_order_relaxed) && pred(set[i]))
+                    found.store(true, std::memory_order_relaxed);
+            });
+        return found.load();
+    }
+
+    /**
+     * @brief Check, in parallel, if a predicate holds
+     *        for all service providers in a set
+     *
+     * @note Once the predicate fails, remaining calls are cancelled.
+     *
+     * @tparam Set Set of service providers (for example, dip::instance_set)
+     * @tparam Predicate Callable taking a service provider instance
+     * @param set Set of service providers
+     * @param pred Predicate
+     * @return true If @p pred holds for all service providers
+     * @return false Otherwise
+     */
+    template <class Set, class Predicate>
+    inline bool all_of(Set &set, Predicate pred)
+    {
+        return !any_of(
+            set,
+            [&pred](auto provider)
+            { return !pred(provider); });
+    }
+
+    /**
+     * @brief Call a function on redundant service providers,
+     *        hedging against slow ones
+     *
+     * @note The first service provider in the set is called.
+     *       If no result arrives within @p delay (or that call fails),
+     *       the next service provider is called, and so on.
+     *       The first result to arrive is returned.
+     *       Then, a stop is requested to all calls still running,
+     *       which should check the given std::stop_token.
+     *       Calls run on the injected dip::Executor.
+     *
+     * @warning Returns before slow calls are complete,
+     *          so service providers must outlive @p set
+     *          (for example, singletons).
+     *          @p fn is moved into state shared with those calls,
+     *          so it must capture by value, not by reference.
+     *
+     * @tparam Set Set of service providers (for example, dip::instance_set)
+     * @tparam Function Callable taking a service provider instance
+     *                  and a std::stop_token
+     * @param set Set of service providers (not empty)
+     * @param fn Function to call
+     * @param delay Time to wait before calling the next service provider
+     * @return auto Result of the first successful call
+     * @throw Exception thrown by the last call, if all of them fail
+     */
+    template <class Set, class Function, class Rep, class Period>
+    inline auto hedge(
+        Set &set,
+        Function fn,
+        const std::chrono::duration<Rep, Period> &delay)
+    {
+        using provider_type = decltype(set[0]);
+        using result_type =
+            std::invoke_result_t<Function &, provider_type, std::stop_token>;
+
+        struct state
+        {
+            state(Function &&fn) : fn{std::move(fn)} {}
+
+            Function fn;
+            std::stop_source stop;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::optional<result_type> result;
+            std::exception_ptr error;
+            std::size_t failures = 0;
+        };
+
+        assert((set.size() > 0) && "No service providers to hedge");
+        instance<Executor> executor;
+        auto shared = std::make_shared<state>(std::move(fn));
+        std::size_t launched = 0;
+        std::unique_lock lock(shared->mutex);
+        while (true)
+        {
+            if (launched < set.size())
+            {
+                provider_type provider = set[launched++];
+                lock.unlock();
+                executor->submit(
+                    [shared, provider]()
+                    {
+                        auto token = shared->stop.get_token();
+                        if (token.stop_requested())
+                            return;
+                        try
+                        {
+                            auto result = shared->fn(provider, token);
+                            std::lock_guard guard(shared->mutex);
+                            if (!shared->result)
+                            {
+                                shared->result.emplace(std::move(result));
+                                shared->stop.request_stop();
+                            }
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard guard(shared->mutex);
+                            shared->failures++;
+                            shared->error = std::current_exception();
+                        }
+                        shared->done.notify_all();
+                    });
+                lock.lock();
+            }
+            auto finished = [&]()
+            { return shared->result || (shared->failures == launched); };
+            if (launched < set.size())
+                shared->done.wait_for(lock, delay, finished);
+            else
+                shared->done.wait(lock, finished);
+            if (shared->result)
+                return std::move(*shared->result);
+            if ((shared->failures == launched) && (launched == set.size()))
+                std::rethrow_exception(shared->error);
+        }
+    }
+}; // namespace dip